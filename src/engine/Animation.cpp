@@ -1,90 +1,153 @@
 #include "Animation.h"
+#include <algorithm>
 
-Animation::Animation(const std::string& name, bool looping)
+AnimationClip::AnimationClip(const std::string& name, const std::vector<AnimationFrame>& frames, bool looping)
     : name(name)
-    , totalDuration(0.0f)
-    , isLooping(looping)
-    , currentFrameIndex(0)
-    , currentFrameTime(0.0f)
-    , isPlaying(false)
+    , id(hashString(name.data(), name.size()))
+    , ownedFrames(frames)
+    , looping(looping)
+    , events(nullptr)
+    , eventCount(0)
 {
-}
-
-void Animation::addFrame(int x, int y, int width, int height, float duration) {
-    // Uywamy emplace_back zamiast push_back dla lepszej wydajnoci
-    // Konstruuje obiekt AnimationFrame bezporednio w wektorze, unikajc kopii
-    frames.emplace_back(x, y, width, height, duration);
-    totalDuration += duration;  // Aktualizacja cakowitego czasu trwania animacji
-}
+    // Indeks klatki w stanie ma 8 bitów
+    if (ownedFrames.size() > 256) {
+        ownedFrames.erase(ownedFrames.begin() + 256, ownedFrames.end());
+    }
 
-const AnimationFrame& Animation::getCurrentFrame() const {
-    // Zabezpieczenie przed dostpem do pustego wektora
-    // Zwraca domyln klatk jeli wektor jest pusty
-    if (frames.empty()) {
-        static AnimationFrame defaultFrame(0, 0, 0, 0, 0.0f);
-        return defaultFrame;
+    ownedEnds.reserve(ownedFrames.size());
+    float total = 0.0f;
+    for (const AnimationFrame& frame : ownedFrames) {
+        total += frame.duration;
+        ownedEnds.push_back(total);
     }
-    return frames[currentFrameIndex];
+    bindOwned();
 }
 
-void Animation::play() {
-    isPlaying = true;
+AnimationClip::AnimationClip(const std::string& name, const AnimationFrame* frames, const float* frameEnds,
+    int frameCount, bool looping, const AnimationClipEvent* events, int eventCount)
+    : name(name)
+    , id(hashString(name.data(), name.size()))
+    , frames(frames)
+    , frameEnds(frameEnds)
+    , frameCount(frameCount < 0 ? 0 : (frameCount > 256 ? 256 : frameCount))
+    , looping(looping)
+    , events(events)
+    , eventCount(events && eventCount > 0 ? eventCount : 0)
+{
 }
 
-void Animation::pause() {
-    isPlaying = false;
+AnimationClip::AnimationClip(const AnimationClip& other)
+    : name(other.name)
+    , id(other.id)
+    , ownedFrames(other.ownedFrames)
+    , ownedEnds(other.ownedEnds)
+    , frames(other.frames)
+    , frameEnds(other.frameEnds)
+    , frameCount(other.frameCount)
+    , looping(other.looping)
+    , ownedEvents(other.ownedEvents)
+    , events(other.events)
+    , eventCount(other.eventCount)
+{
+    // Kopia własnych tablic musi wskazywać własne dane, nie oryginału
+    if (other.ownsFrames()) {
+        bindOwned();
+    }
+    if (other.events == other.ownedEvents.data()) {
+        events = ownedEvents.data();
+    }
 }
 
-void Animation::stop() {
-    isPlaying = false;
-    reset();
+AnimationClip& AnimationClip::operator=(const AnimationClip& other) {
+    if (this != &other) {
+        name = other.name;
+        id = other.id;
+        ownedFrames = other.ownedFrames;
+        ownedEnds = other.ownedEnds;
+        frames = other.frames;
+        frameEnds = other.frameEnds;
+        frameCount = other.frameCount;
+        looping = other.looping;
+        ownedEvents = other.ownedEvents;
+        events = other.events;
+        eventCount = other.eventCount;
+        if (other.ownsFrames()) {
+            bindOwned();
+        }
+        if (other.events == other.ownedEvents.data()) {
+            events = ownedEvents.data();
+        }
+    }
+    return *this;
 }
 
-void Animation::reset() {
-    currentFrameIndex = 0;
-    currentFrameTime = 0.0f;
+void AnimationClip::bindOwned() {
+    frames = ownedFrames.data();
+    frameEnds = ownedEnds.data();
+    frameCount = static_cast<int>(ownedFrames.size());
 }
 
-void Animation::update(float deltaTime) {
-    if (!isPlaying || frames.empty()) return;
-
-    currentFrameTime += deltaTime;
-
-    while (currentFrameTime >= frames[currentFrameIndex].duration) {
-        // Odejmujemy czas aktualnej klatki i przechodzimy do nastpnej
-        currentFrameTime -= frames[currentFrameIndex].duration;
-        currentFrameIndex++;
-
-        // Logika zaptlania animacji
-        if (currentFrameIndex >= frames.size()) {
-            if (isLooping) {
-                currentFrameIndex = 0;  // Wracamy na pocztek animacji
-            }
-            else {
-                currentFrameIndex = frames.size() - 1;  // Zostajemy na ostatniej klatce
-                isPlaying = false;
-                break;  // Przerywamy ptl, bo animacja si skoczya
-            }
+AnimationClip AnimationClip::fromGrid(const std::string& name, int frameWidth, int frameHeight,
+    int firstRow, int rows, int columns, float frameDuration, bool looping) {
+    std::vector<AnimationFrame> frames;
+    frames.reserve(rows * columns);
+    for (int row = firstRow; row < firstRow + rows; row++) {
+        for (int col = 0; col < columns; col++) {
+            frames.emplace_back(col * frameWidth, row * frameHeight, frameWidth, frameHeight, frameDuration);
         }
     }
+    return AnimationClip(name, frames, looping);
 }
 
-bool Animation::isFinished() const {
-    return !isLooping && !isPlaying && currentFrameIndex == frames.size() - 1;
+void AnimationClip::setEvents(const std::vector<AnimationClipEvent>& clipEvents) {
+    ownedEvents.clear();
+    for (const AnimationClipEvent& event : clipEvents) {
+        if (event.frame <= static_cast<uint32_t>(frameCount)) {
+            ownedEvents.push_back(event);
+        }
+    }
+    events = ownedEvents.data();
+    eventCount = static_cast<int>(ownedEvents.size());
 }
 
-std::string Animation::getName() const {
-    return name;
+int AnimationClip::frameIndexAt(float time) const {
+    // Pierwsza klatka, której koniec jest późniejszy niż czas
+    const float* end = frameEnds + frameCount;
+    const float* it = std::upper_bound(frameEnds, end, time);
+    if (it == end) {
+        return frameCount - 1;
+    }
+    return static_cast<int>(it - frameEnds);
 }
 
-bool Animation::getIsLooping() const {
-    return isLooping;
+const AnimationFrame& AnimationClip::getFrame(int index) const {
+    // Zabezpieczenie przed dostępem do pustego wektora
+    if (frameCount == 0) {
+        static AnimationFrame defaultFrame(0, 0, 0, 0, 0.0f);
+        return defaultFrame;
+    }
+    return frames[index];
 }
 
-bool Animation::getIsPlaying() const {
-    return isPlaying;
-}
+void AnimationClip::advance(AnimationState& state, float deltaTime) const {
+    if (!state.isPlaying() || frameCount == 0) return;
+
+    float total = frameEnds[frameCount - 1];
+    state.time += deltaTime;
+
+    if (state.time >= total) {
+        if (looping && total > 0.0f) {
+            // Logika zapętlania - reszta z dzielenia zamiast wielokrotnego odejmowania
+            state.time -= total * static_cast<float>(static_cast<int>(state.time / total));
+        }
+        else {
+            // Zostajemy na ostatniej klatce
+            state.time = total;
+            state.frameIndex = static_cast<uint8_t>(frameCount - 1);
+            state.flags = static_cast<uint8_t>((state.flags & ~AnimationState::PLAYING) | AnimationState::FINISHED);
+            return;
+        }
+    }
 
-void Animation::setLooping(bool loop) {
-    isLooping = loop;
+    state.frameIndex = static_cast<uint8_t>(frameIndexAt(state.time));
 }
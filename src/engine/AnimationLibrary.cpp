@@ -0,0 +1,64 @@
+﻿#include "AnimationLibrary.h"
+#include <algorithm>
+
+AnimationLibrary* AnimationLibrary::instance = nullptr;
+
+AnimationLibrary::~AnimationLibrary() {
+    clear();
+}
+
+AnimationLibrary* AnimationLibrary::getInstance() {
+    if (!instance) {
+        instance = new AnimationLibrary();
+    }
+    return instance;
+}
+
+void AnimationLibrary::releaseInstance() {
+    if (instance) {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+AnimationClipId AnimationLibrary::addClip(const AnimationClip& clip) {
+    AnimationClipId existing = find(clip.getId());
+    if (existing != INVALID_ANIMATION_CLIP) {
+        // Ten sam skrót innej nazwy - klip byłby nieosiągalny, a find(StringId) zwracałby cudzy
+        if (clips[existing]->getName() != clip.getName()) {
+            logger.error("Animation clip name collision: \"" + clip.getName() + "\" and \"" +
+                clips[existing]->getName() + "\"");
+            return INVALID_ANIMATION_CLIP;
+        }
+        return existing;
+    }
+    if (clips.size() >= INVALID_ANIMATION_CLIP) {
+        return INVALID_ANIMATION_CLIP;
+    }
+
+    AnimationClipId id = static_cast<AnimationClipId>(clips.size());
+    clips.push_back(new AnimationClip(clip));
+    StringTable::getInstance()->intern(clip.getName());
+
+    std::pair<StringId, AnimationClipId> entry(clip.getId(), id);
+    ids.insert(std::lower_bound(ids.begin(), ids.end(), entry), entry);
+    return id;
+}
+
+AnimationClipId AnimationLibrary::find(StringId name) const {
+    auto it = std::lower_bound(ids.begin(), ids.end(), std::make_pair(name, AnimationClipId(0)));
+    return it != ids.end() && it->first == name ? it->second : INVALID_ANIMATION_CLIP;
+}
+
+AnimationClipId AnimationLibrary::find(const std::string& name) const {
+    AnimationClipId id = find(hashString(name.data(), name.size()));
+    return id != INVALID_ANIMATION_CLIP && clips[id]->getName() == name ? id : INVALID_ANIMATION_CLIP;
+}
+
+void AnimationLibrary::clear() {
+    for (AnimationClip* clip : clips) {
+        delete clip;
+    }
+    clips.clear();
+    ids.clear();
+}
@@ -0,0 +1,86 @@
+﻿/**
+ * @file AnimationLibrary.h
+ * @brief Biblioteka współdzielonych klipów animacji (Singleton)
+ *
+ * Klipy są rejestrowane raz (zwykle przy pierwszym ładowaniu zasobów danego
+ * typu obiektu) i adresowane 16-bitowym identyfikatorem (indeks tablicy).
+ * Nazwy są wyszukiwane po StringId w posortowanej tablicy par, bez
+ * porównywania napisów. Każdy skrót należy do co najwyżej jednej nazwy -
+ * addClip odrzuca klip, którego nazwa ma ten sam skrót co inny już
+ * zarejestrowany klip. Stany odtwarzania (z identyfikatorem klipu)
+ * przechowuje AnimationSystem.
+ */
+
+#ifndef ANIMATION_LIBRARY_H
+#define ANIMATION_LIBRARY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "Animation.h"
+#include "Logger.h"
+
+ /**
+  * @brief Właściciel wszystkich klipów animacji
+  */
+class AnimationLibrary {
+private:
+    static AnimationLibrary* instance;          ///< Instancja Singletona
+
+    std::vector<AnimationClip*> clips;          ///< Klipy (indeks = identyfikator)
+    std::vector<std::pair<StringId, AnimationClipId>> ids;  ///< Nazwa -> identyfikator, posortowane po StringId
+    Logger logger;                              ///< Logger do zgłaszania kolizji nazw
+
+    AnimationLibrary() {}
+    ~AnimationLibrary();
+
+    // Zablokowanie kopiowania (Singleton)
+    AnimationLibrary(const AnimationLibrary&) = delete;
+    AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+
+public:
+    static AnimationLibrary* getInstance();
+    static void releaseInstance();
+
+    /**
+     * @brief Rejestruje klip
+     * @param clip Klip do dodania
+     * @return Identyfikator klipu; jeśli klip o tej nazwie już istnieje,
+     *         zwracany jest jego identyfikator, a nowy klip jest pomijany.
+     *         INVALID_ANIMATION_CLIP, gdy skrót nazwy należy do innego klipu.
+     */
+    AnimationClipId addClip(const AnimationClip& clip);
+
+    /**
+     * @brief Wyszukuje klip po identyfikatorze nazwy (wyszukiwanie binarne)
+     * @param name Identyfikator nazwy klipu (np. "player_idle"_sid)
+     * @return Identyfikator klipu lub INVALID_ANIMATION_CLIP
+     */
+    AnimationClipId find(StringId name) const;
+
+    /**
+     * @brief Wyszukuje klip po nazwie (skrót i porównanie nazwy)
+     * @param name Nazwa klipu
+     * @return Identyfikator klipu lub INVALID_ANIMATION_CLIP
+     */
+    AnimationClipId find(const std::string& name) const;
+
+    /**
+     * @brief Pobiera klip
+     * @param id Identyfikator klipu
+     * @return Wskaźnik na klip lub nullptr dla nieznanego identyfikatora
+     */
+    const AnimationClip* get(AnimationClipId id) const {
+        return id < clips.size() ? clips[id] : nullptr;
+    }
+
+    bool contains(StringId name) const { return find(name) != INVALID_ANIMATION_CLIP; }
+    size_t getClipCount() const { return clips.size(); }
+
+    /**
+     * @brief Usuwa wszystkie klipy (unieważnia identyfikatory)
+     */
+    void clear();
+};
+
+#endif // ANIMATION_LIBRARY_H
@@ -0,0 +1,384 @@
+﻿#include "AnimationSystem.h"
+#include "AnimationLibrary.h"
+#include <algorithm>
+#include <cmath>
+
+AnimationSystem* AnimationSystem::instance = nullptr;
+
+AnimationSystem::AnimationSystem()
+    : viewPixelScale(1.0f)
+    , viewValid(false)
+    , tick(0)
+    , lodStats()
+    , eventsDispatched(0)
+{
+}
+
+AnimationSystem* AnimationSystem::getInstance() {
+    if (!instance) {
+        instance = new AnimationSystem();
+    }
+    return instance;
+}
+
+void AnimationSystem::releaseInstance() {
+    if (instance) {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+AnimationHandle AnimationSystem::create() {
+    AnimationHandle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    else {
+        handle = static_cast<AnimationHandle>(handleToDense.size());
+        handleToDense.push_back(INVALID_ANIMATION_HANDLE);
+    }
+
+    handleToDense[handle] = static_cast<uint32_t>(times.size());
+    times.push_back(0.0f);
+    rates.push_back(0.0f);
+    durations.push_back(0.0f);
+    loopMasks.push_back(0.0f);
+    clips.push_back(INVALID_ANIMATION_CLIP);
+    frameIndices.push_back(0);
+    flags.push_back(0);
+    rects.push_back(AnimationSourceRect{ 0, 0, 0, 0, 0, 0, 0, 0 });
+    positions.push_back(Vec2());
+    radii.push_back(-1.0f);
+    lods.push_back(AnimationLod::FULL);
+    listeners.push_back(nullptr);
+    denseToHandle.push_back(handle);
+    return handle;
+}
+
+void AnimationSystem::destroy(AnimationHandle handle) {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE) return;
+
+    // Ostatni element przenoszony na zwolnione miejsce - tablice pozostają ciągłe
+    uint32_t last = static_cast<uint32_t>(times.size() - 1);
+    if (index != last) {
+        times[index] = times[last];
+        rates[index] = rates[last];
+        durations[index] = durations[last];
+        loopMasks[index] = loopMasks[last];
+        clips[index] = clips[last];
+        frameIndices[index] = frameIndices[last];
+        flags[index] = flags[last];
+        rects[index] = rects[last];
+        positions[index] = positions[last];
+        radii[index] = radii[last];
+        lods[index] = lods[last];
+        listeners[index] = listeners[last];
+        denseToHandle[index] = denseToHandle[last];
+        handleToDense[denseToHandle[index]] = index;
+    }
+
+    times.pop_back();
+    rates.pop_back();
+    durations.pop_back();
+    loopMasks.pop_back();
+    clips.pop_back();
+    frameIndices.pop_back();
+    flags.pop_back();
+    rects.pop_back();
+    positions.pop_back();
+    radii.pop_back();
+    lods.pop_back();
+    listeners.pop_back();
+    denseToHandle.pop_back();
+
+    handleToDense[handle] = INVALID_ANIMATION_HANDLE;
+    freeHandles.push_back(handle);
+}
+
+void AnimationSystem::applyFrame(uint32_t index, const AnimationClip& clip, int frame) {
+    frameIndices[index] = static_cast<uint8_t>(frame);
+    flags[index] &= static_cast<uint8_t>(~FRAME_STALE);
+    const AnimationFrame& source = clip.getFrame(frame);
+    rects[index] = AnimationSourceRect{ source.x, source.y, source.width, source.height,
+        source.offsetX, source.offsetY, source.cellWidth, source.cellHeight };
+}
+
+void AnimationSystem::play(AnimationHandle handle, AnimationClipId clipId) {
+    uint32_t index = indexOf(handle);
+    const AnimationClip* clip = AnimationLibrary::getInstance()->get(clipId);
+    if (index == INVALID_ANIMATION_HANDLE || !clip) return;
+
+    // Zdarzenia pierwszej klatki - przy rozpoczęciu klipu od początku
+    bool fromStart = clips[index] != clipId || (times[index] == 0.0f && !(flags[index] & AnimationState::PLAYING));
+    if (clips[index] != clipId) {
+        clips[index] = clipId;
+        times[index] = 0.0f;
+        durations[index] = clip->getTotalDuration();
+        loopMasks[index] = clip->isLooping() ? 1.0f : 0.0f;
+        applyFrame(index, *clip, 0);
+    }
+    if (fromStart && clip->hasEvents()) {
+        queueStartEvents(index, *clip);
+    }
+    flags[index] = static_cast<uint8_t>((flags[index] | AnimationState::PLAYING) & ~AnimationState::FINISHED);
+    rates[index] = 1.0f;
+}
+
+void AnimationSystem::stop(AnimationHandle handle) {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE) return;
+
+    times[index] = 0.0f;
+    rates[index] = 0.0f;
+    flags[index] = 0;
+    const AnimationClip* clip = AnimationLibrary::getInstance()->get(clips[index]);
+    if (clip) {
+        applyFrame(index, *clip, 0);
+    }
+}
+
+void AnimationSystem::pause(AnimationHandle handle) {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE) return;
+
+    flags[index] &= static_cast<uint8_t>(~AnimationState::PLAYING);
+    rates[index] = 0.0f;
+}
+
+void AnimationSystem::resume(AnimationHandle handle) {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE || clips[index] == INVALID_ANIMATION_CLIP) return;
+    if (flags[index] & AnimationState::FINISHED) return;
+
+    flags[index] |= AnimationState::PLAYING;
+    rates[index] = 1.0f;
+}
+
+bool AnimationSystem::resolveFrame(uint32_t index, const AnimationClip& clip) {
+    int frame = frameIndices[index];
+    float time = times[index];
+    if (time >= clip.getFrameStart(frame) && time < clip.getFrameEnd(frame)) {
+        flags[index] &= static_cast<uint8_t>(~FRAME_STALE);
+        return false;
+    }
+    applyFrame(index, clip, clip.frameIndexAt(time));
+    return true;
+}
+
+void AnimationSystem::setBounds(AnimationHandle handle, const Vec2& center, float scale) {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE) return;
+
+    // Promień okręgu opisanego na pełnej komórce (rozmiar komórek klipu jest zwykle stały)
+    const AnimationSourceRect& rect = rects[index];
+    positions[index] = center;
+    radii[index] = 0.5f * std::sqrt(static_cast<float>(rect.cellWidth * rect.cellWidth + rect.cellHeight * rect.cellHeight)) * std::fabs(scale);
+}
+
+void AnimationSystem::setView(const AABB& visible, float pixelScale) {
+    view = visible;
+    viewPixelScale = pixelScale;
+    viewValid = !visible.isEmpty();
+}
+
+void AnimationSystem::classify() {
+    const size_t count = times.size();
+    if (!lodSettings.enabled || !viewValid) {
+        std::fill(lods.begin(), lods.end(), AnimationLod::FULL);
+        lodStats.full = count;
+        return;
+    }
+
+    Vec2 center = view.getCenter();
+    Vec2 half = view.getHalfExtents();
+    float minFullRadius = 0.5f * lodSettings.minFullRatePixels / (viewPixelScale > 0.0f ? viewPixelScale : 1.0f);
+
+    for (size_t i = 0; i < count; i++) {
+        float radius = radii[i];
+        if (radius < 0.0f) {
+            lods[i] = AnimationLod::FULL;
+            lodStats.full++;
+            continue;
+        }
+
+        float dx = std::fabs(positions[i].x - center.x) - radius;
+        float dy = std::fabs(positions[i].y - center.y) - radius;
+        bool visible = dx <= half.x && dy <= half.y;
+        bool near = dx <= half.x + lodSettings.margin && dy <= half.y + lodSettings.margin;
+
+        if (visible) {
+            lods[i] = radius < minFullRadius ? AnimationLod::REDUCED : AnimationLod::FULL;
+        }
+        else {
+            lods[i] = near ? AnimationLod::REDUCED : AnimationLod::CLOCK_ONLY;
+        }
+        lodStats.full += lods[i] == AnimationLod::FULL;
+        lodStats.reduced += lods[i] == AnimationLod::REDUCED;
+        lodStats.clockOnly += lods[i] == AnimationLod::CLOCK_ONLY;
+    }
+}
+
+void AnimationSystem::update(float deltaTime) {
+    const size_t count = times.size();
+    lodStats.full = lodStats.reduced = lodStats.clockOnly = lodStats.framesResolved = 0;
+    tick++;
+    if (count == 0) return;
+
+    classify();
+    previousTimes.assign(times.begin(), times.end());
+
+    float* time = times.data();
+    const float* rate = rates.data();
+    const float* duration = durations.data();
+    const float* loop = loopMasks.data();
+
+    // Przebieg 1: czas i zawinięcie pętli bez rozgałęzień (wektoryzowalny), dla każdego poziomu LOD.
+    // Zawinięcie dotyczy tylko klipów zapętlonych (loop = 1) o niezerowej długości;
+    // dla pozostałych wrap = 0 i czas rośnie do końca klipu.
+    for (size_t i = 0; i < count; i++) {
+        float t = time[i] + deltaTime * rate[i];
+        float safeDuration = duration[i] > 0.0f ? duration[i] : 1.0f;
+        float cycles = static_cast<float>(static_cast<int>(t / safeDuration));
+        float wrap = (t >= duration[i] && duration[i] > 0.0f) ? loop[i] : 0.0f;
+        time[i] = t - wrap * cycles * safeDuration;
+    }
+
+    // Przebieg 2: klatka - zwykle czas nadal mieści się w bieżącej klatce
+    AnimationLibrary* library = AnimationLibrary::getInstance();
+    AnimationClipId cachedId = INVALID_ANIMATION_CLIP;
+    const AnimationClip* clip = nullptr;
+    unsigned interval = static_cast<unsigned>(lodSettings.reducedInterval > 1 ? lodSettings.reducedInterval : 1);
+
+    for (size_t i = 0; i < count; i++) {
+        if (rate[i] == 0.0f) continue;
+
+        // Sąsiednie stany często odtwarzają ten sam klip
+        if (clips[i] != cachedId) {
+            cachedId = clips[i];
+            clip = library->get(cachedId);
+        }
+        if (!clip || clip->getFrameCount() == 0) continue;
+
+        uint32_t index = static_cast<uint32_t>(i);
+        if (clip->hasEvents()) {
+            collectEvents(index, *clip, previousTimes[i], previousTimes[i] + deltaTime * rate[i]);
+        }
+        if (time[i] >= duration[i] && loop[i] == 0.0f) {
+            // Niezapętlony klip doszedł do końca - zostajemy na ostatniej klatce (każdy poziom LOD)
+            time[i] = duration[i];
+            rates[i] = 0.0f;
+            flags[i] = static_cast<uint8_t>((flags[i] & ~AnimationState::PLAYING) | AnimationState::FINISHED);
+            applyFrame(index, *clip, clip->getFrameCount() - 1);
+            lodStats.framesResolved++;
+            continue;
+        }
+
+        // Pominięta klatka jest oznaczana i wyznaczana przy odczycie
+        if (lods[i] == AnimationLod::CLOCK_ONLY ||
+            (lods[i] == AnimationLod::REDUCED && (tick + i) % interval != 0)) {
+            flags[i] |= FRAME_STALE;
+            continue;
+        }
+        if (resolveFrame(index, *clip)) {
+            lodStats.framesResolved++;
+        }
+    }
+}
+
+void AnimationSystem::collectEvents(uint32_t index, const AnimationClip& clip, float from, float to) {
+    float duration = clip.getTotalDuration();
+    bool looping = loopMasks[index] != 0.0f && duration > 0.0f;
+
+    // Zdarzenie jest zgłaszane, gdy jego czas (lub dla pętli: czas + k * długość)
+    // mieści się w przedziale (from, to] przesunięcia z tej aktualizacji
+    for (int e = 0; e < clip.getEventCount(); e++) {
+        float eventTime = clip.getEventTime(e);
+        bool fired;
+        if (looping) {
+            float cycle = std::floor((from - eventTime) / duration) + 1.0f;
+            fired = eventTime + std::max(cycle, 0.0f) * duration <= to;
+        }
+        else {
+            fired = from < eventTime && eventTime <= to;
+        }
+
+        if (fired) {
+            const AnimationClipEvent& event = clip.getEvent(e);
+            pendingEvents.push_back(AnimationEvent{ denseToHandle[index], clips[index], event.name,
+                static_cast<int>(event.frame) });
+        }
+    }
+}
+
+void AnimationSystem::queueStartEvents(uint32_t index, const AnimationClip& clip) {
+    for (int e = 0; e < clip.getEventCount(); e++) {
+        const AnimationClipEvent& event = clip.getEvent(e);
+        if (event.frame == 0 && clip.getFrameCount() > 0) {
+            pendingEvents.push_back(AnimationEvent{ denseToHandle[index], clips[index], event.name, 0 });
+        }
+    }
+}
+
+void AnimationSystem::setListener(AnimationHandle handle, AnimationEventListener* listener) {
+    uint32_t index = indexOf(handle);
+    if (index != INVALID_ANIMATION_HANDLE) {
+        listeners[index] = listener;
+    }
+}
+
+void AnimationSystem::dispatchEvents() {
+    // Odbiorca może odtworzyć inny klip lub usunąć sprite - kolejka jest
+    // wcześniej przenoszona, a odbiorca wyszukiwany po uchwycie przy każdym zdarzeniu
+    dispatching.swap(pendingEvents);
+    for (const AnimationEvent& event : dispatching) {
+        uint32_t index = indexOf(event.handle);
+        if (index == INVALID_ANIMATION_HANDLE || !listeners[index]) continue;
+        listeners[index]->onAnimationEvent(event);
+        eventsDispatched++;
+    }
+    dispatching.clear();
+}
+
+const AnimationSourceRect* AnimationSystem::getSourceRect(AnimationHandle handle) {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE || clips[index] == INVALID_ANIMATION_CLIP) return nullptr;
+
+    if (flags[index] & FRAME_STALE) {
+        const AnimationClip* clip = AnimationLibrary::getInstance()->get(clips[index]);
+        if (clip && clip->getFrameCount() > 0) {
+            resolveFrame(index, *clip);
+            lodStats.resolvedOnDemand++;
+        }
+    }
+    return &rects[index];
+}
+
+void AnimationSystem::reportStats(EngineStats& stats) {
+    stats.setCounter("anim.states", static_cast<long>(times.size()));
+    stats.setCounter("anim.full", static_cast<long>(lodStats.full));
+    stats.setCounter("anim.reduced", static_cast<long>(lodStats.reduced));
+    stats.setCounter("anim.clock_only", static_cast<long>(lodStats.clockOnly));
+    stats.setCounter("anim.resolved", static_cast<long>(lodStats.framesResolved));
+    stats.setCounter("anim.on_demand", static_cast<long>(lodStats.resolvedOnDemand));
+    stats.setCounter("anim.events", static_cast<long>(eventsDispatched));
+    lodStats.resolvedOnDemand = 0;
+    eventsDispatched = 0;
+}
+
+AnimationState AnimationSystem::getState(AnimationHandle handle) const {
+    uint32_t index = indexOf(handle);
+    if (index == INVALID_ANIMATION_HANDLE) {
+        return makeAnimationState();
+    }
+    // Nieaktualna klatka jest wyznaczana tylko w kopii - stan systemu się nie zmienia
+    AnimationState state = { times[index], clips[index], frameIndices[index],
+        static_cast<uint8_t>(flags[index] & ~FRAME_STALE) };
+    if (flags[index] & FRAME_STALE) {
+        if (const AnimationClip* clip = AnimationLibrary::getInstance()->get(clips[index])) {
+            state.frameIndex = static_cast<uint8_t>(clip->frameIndexAt(times[index]));
+        }
+    }
+    return state;
+}
@@ -0,0 +1,310 @@
+﻿/**
+ * @file AnimationSystem.h
+ * @brief Wsadowa aktualizacja wszystkich animacji w układzie SoA (Singleton)
+ *
+ * Stany odtwarzania wszystkich sprite'ów leżą w ciągłych tablicach
+ * (czas, tempo, długość klipu, klip, klatka, flagi, prostokąt źródłowy)
+ * i są przesuwane jednym przebiegiem na klatkę gry:
+ * - dodanie czasu i zawinięcie pętli - pętla bez skoków po tablicach float
+ *   (wektoryzowana przez kompilator),
+ * - wyznaczenie klatki - najpierw sprawdzenie, czy czas nadal mieści się
+ *   w bieżącej klatce, a dopiero potem wyszukiwanie binarne w sumach
+ *   prefiksowych klipu,
+ * - zapis prostokąta źródłowego tylko przy zmianie klatki.
+ * Sprite przechowuje jedynie uchwyt i przy rysowaniu czyta prostokąt
+ * bezpośrednio z tablicy systemu.
+ *
+ * Poziom szczegółowości (LOD) wyznaczany jest z widoku kamery (setView):
+ * - FULL - sprite widoczny: klatka wyznaczana co aktualizację,
+ * - REDUCED - sprite widoczny, ale mały na ekranie, lub tuż poza widokiem:
+ *   klatka wyznaczana co reducedInterval aktualizacji (z rozłożeniem
+ *   między stany),
+ * - CLOCK_ONLY - sprite daleko poza widokiem: przesuwany jest tylko czas.
+ * Stan, którego klatka nie została wyznaczona, jest oznaczany jako
+ * nieaktualny i wyznaczany przy pierwszym odczycie prostokąta
+ * (getSourceRect), więc sprite wchodzący w widok zawsze ma właściwą klatkę.
+ * Zakończenie niezapętlonego klipu wykrywane jest na każdym poziomie.
+ *
+ * Zdarzenia klipów (AnimationClipEvent) wykrywane są z czasu odtwarzania,
+ * niezależnie od LOD, i trafiają do kolejki. dispatchEvents przekazuje je
+ * słuchaczom stanów (AnimationEventListener) po aktualizacji, więc logika
+ * gry (np. koniec przeładowania) pozostaje zsynchronizowana z animacją
+ * bez własnych liczników czasu.
+ */
+
+#ifndef ANIMATION_SYSTEM_H
+#define ANIMATION_SYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Animation.h"
+#include "Bounds.h"
+#include "EngineStats.h"
+
+ /**
+  * @brief Uchwyt stanu animacji w AnimationSystem
+  */
+typedef uint32_t AnimationHandle;
+
+/**
+ * @brief Uchwyt oznaczający brak stanu
+ */
+const AnimationHandle INVALID_ANIMATION_HANDLE = 0xFFFFFFFFu;
+
+/**
+ * @brief Prostokąt źródłowy klatki w sprite sheet
+ */
+struct AnimationSourceRect {
+    int x;       ///< Pozycja X w teksturze
+    int y;       ///< Pozycja Y w teksturze
+    int width;   ///< Szerokość (0 dla klatki całkowicie przezroczystej)
+    int height;  ///< Wysokość
+    int offsetX;     ///< Przesunięcie X w pełnej komórce (klatka przycięta)
+    int offsetY;     ///< Przesunięcie Y w pełnej komórce
+    int cellWidth;   ///< Szerokość pełnej komórki (rozmiar logiczny sprite'a)
+    int cellHeight;  ///< Wysokość pełnej komórki
+};
+
+/**
+ * @brief Poziom szczegółowości animacji
+ */
+enum class AnimationLod : uint8_t {
+    FULL,        ///< Klatka wyznaczana co aktualizację
+    REDUCED,     ///< Klatka wyznaczana co reducedInterval aktualizacji
+    CLOCK_ONLY   ///< Tylko czas - klatka wyznaczana przy odczycie
+};
+
+/**
+ * @brief Parametry wyboru poziomu szczegółowości
+ */
+struct AnimationLodSettings {
+    bool enabled;              ///< Czy LOD jest włączony (wyłączony - wszystko FULL)
+    float margin;              ///< Pas wokół widoku (jednostki świata) z poziomem REDUCED
+    float minFullRatePixels;   ///< Rozmiar na ekranie (piksele), poniżej którego sprite ma REDUCED
+    int reducedInterval;       ///< Co ile aktualizacji wyznaczana jest klatka dla REDUCED
+
+    AnimationLodSettings()
+        : enabled(true)
+        , margin(256.0f)
+        , minFullRatePixels(24.0f)
+        , reducedInterval(4)
+    {
+    }
+};
+
+/**
+ * @brief Liczniki pracy systemu animacji
+ */
+struct AnimationLodStats {
+    size_t full;               ///< Stany na poziomie FULL (ostatnia aktualizacja)
+    size_t reduced;            ///< Stany na poziomie REDUCED
+    size_t clockOnly;          ///< Stany na poziomie CLOCK_ONLY
+    size_t framesResolved;     ///< Klatki wyznaczone w ostatniej aktualizacji
+    size_t resolvedOnDemand;   ///< Klatki wyznaczone przy odczycie od ostatniego raportu
+};
+
+/**
+ * @brief Zgłoszone zdarzenie animacji
+ */
+struct AnimationEvent {
+    AnimationHandle handle;  ///< Stan, który zgłosił zdarzenie
+    AnimationClipId clip;    ///< Odtwarzany klip
+    StringId name;           ///< Nazwa zdarzenia
+    int frame;               ///< Klatka zdarzenia (liczba klatek - koniec klipu)
+};
+
+/**
+ * @brief Odbiorca zdarzeń animacji (np. encja właściciela sprite'a)
+ */
+class AnimationEventListener {
+public:
+    virtual ~AnimationEventListener() {}
+
+    /**
+     * @brief Wywoływane przez AnimationSystem::dispatchEvents
+     * @param event Zdarzenie
+     */
+    virtual void onAnimationEvent(const AnimationEvent& event) = 0;
+};
+
+/**
+ * @brief System animacji przechowujący stany w tablicach SoA
+ *
+ * Uchwyty są stabilne: usunięcie stanu przenosi ostatni element tablic
+ * na zwolnione miejsce i aktualizuje tablicę przekierowań.
+ */
+class AnimationSystem {
+private:
+    static AnimationSystem* instance;               ///< Instancja Singletona
+
+    // Tablice gęste (indeks = pozycja stanu)
+    std::vector<float> times;                       ///< Czas od początku przebiegu klipu
+    std::vector<float> rates;                       ///< Tempo (0 - wstrzymana, 1 - odtwarzana)
+    std::vector<float> durations;                   ///< Długość klipu (0 - brak klipu)
+    std::vector<float> loopMasks;                   ///< 1 dla klipu zapętlonego, 0 w przeciwnym razie
+    std::vector<AnimationClipId> clips;             ///< Odtwarzany klip
+    std::vector<uint8_t> frameIndices;              ///< Indeks aktualnej klatki
+    std::vector<uint8_t> flags;                     ///< Flagi AnimationState
+    std::vector<AnimationSourceRect> rects;         ///< Prostokąt źródłowy aktualnej klatki
+    std::vector<Vec2> positions;                    ///< Środek sprite'a w świecie
+    std::vector<float> radii;                       ///< Promień otaczający (< 0 - nieznany, zawsze FULL)
+    std::vector<AnimationLod> lods;                 ///< Poziom szczegółowości
+    std::vector<AnimationEventListener*> listeners; ///< Odbiorca zdarzeń (może być nullptr)
+    std::vector<AnimationHandle> denseToHandle;     ///< Pozycja -> uchwyt
+
+    // Przekierowania uchwytów
+    std::vector<uint32_t> handleToDense;            ///< Uchwyt -> pozycja
+    std::vector<AnimationHandle> freeHandles;       ///< Zwolnione uchwyty
+
+    // Widok kamery i LOD
+    AnimationLodSettings lodSettings;               ///< Parametry LOD
+    AABB view;                                      ///< Widoczny obszar świata
+    float viewPixelScale;                           ///< Piksele na jednostkę świata
+    bool viewValid;                                 ///< Czy ustawiono widok
+    unsigned long tick;                             ///< Licznik aktualizacji (rozłożenie REDUCED)
+    AnimationLodStats lodStats;                     ///< Liczniki pracy
+
+    // Zdarzenia
+    std::vector<float> previousTimes;               ///< Czasy sprzed bieżącej aktualizacji
+    std::vector<AnimationEvent> pendingEvents;      ///< Kolejka zdarzeń do przekazania
+    std::vector<AnimationEvent> dispatching;        ///< Zdarzenia w trakcie przekazywania
+    size_t eventsDispatched;                        ///< Przekazane od ostatniego raportu
+
+    /// Flaga wewnętrzna: klatka nie została wyznaczona dla bieżącego czasu
+    static const uint8_t FRAME_STALE = 1 << 7;
+
+    AnimationSystem();
+
+    // Zablokowanie kopiowania (Singleton)
+    AnimationSystem(const AnimationSystem&) = delete;
+    AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+    uint32_t indexOf(AnimationHandle handle) const {
+        return handle < handleToDense.size() ? handleToDense[handle] : INVALID_ANIMATION_HANDLE;
+    }
+    void applyFrame(uint32_t index, const AnimationClip& clip, int frame);
+    bool resolveFrame(uint32_t index, const AnimationClip& clip);
+    void classify();
+    void collectEvents(uint32_t index, const AnimationClip& clip, float from, float to);
+    void queueStartEvents(uint32_t index, const AnimationClip& clip);
+
+public:
+    static AnimationSystem* getInstance();
+    static void releaseInstance();
+
+    /**
+     * @brief Tworzy pusty stan (bez klipu)
+     * @return Uchwyt stanu
+     */
+    AnimationHandle create();
+
+    /**
+     * @brief Usuwa stan
+     * @param handle Uchwyt stanu
+     */
+    void destroy(AnimationHandle handle);
+
+    /**
+     * @brief Rozpoczyna odtwarzanie klipu
+     * @param handle Uchwyt stanu
+     * @param clip Identyfikator klipu w AnimationLibrary
+     *
+     * Zmiana klipu zaczyna go od pierwszej klatki; ponowne wywołanie
+     * dla bieżącego klipu tylko wznawia odtwarzanie.
+     */
+    void play(AnimationHandle handle, AnimationClipId clip);
+
+    /**
+     * @brief Zatrzymuje animację i cofa do pierwszej klatki
+     */
+    void stop(AnimationHandle handle);
+
+    /**
+     * @brief Wstrzymuje animację
+     */
+    void pause(AnimationHandle handle);
+
+    /**
+     * @brief Wznawia wstrzymaną animację
+     */
+    void resume(AnimationHandle handle);
+
+    /**
+     * @brief Ustawia położenie i skalę sprite'a (do wyboru poziomu LOD)
+     * @param handle Uchwyt stanu
+     * @param center Środek sprite'a w świecie
+     * @param scale Największa ze skal sprite'a (promień liczony z rozmiaru klatki)
+     */
+    void setBounds(AnimationHandle handle, const Vec2& center, float scale);
+
+    /**
+     * @brief Ustawia widok kamery używany do wyboru poziomu LOD
+     * @param visible Widoczny obszar świata
+     * @param pixelScale Piksele na jednostkę świata (zoom kamery)
+     */
+    void setView(const AABB& visible, float pixelScale);
+
+    /**
+     * @brief Ustawia odbiorcę zdarzeń stanu
+     * @param handle Uchwyt stanu
+     * @param listener Odbiorca (nullptr - brak); musi istnieć, dopóki istnieje stan
+     */
+    void setListener(AnimationHandle handle, AnimationEventListener* listener);
+
+    /**
+     * @brief Przekazuje zdarzenia z kolejki odbiorcom
+     *
+     * Wywoływane po update. Zdarzenia stanów usuniętych w międzyczasie są
+     * pomijane; zdarzenia zgłoszone podczas przekazywania (np. play
+     * w odbiorcy) trafiają do następnego wywołania.
+     */
+    void dispatchEvents();
+
+    size_t getPendingEventCount() const { return pendingEvents.size(); }
+
+    void setLodSettings(const AnimationLodSettings& settings) { lodSettings = settings; }
+    const AnimationLodSettings& getLodSettings() const { return lodSettings; }
+
+    /**
+     * @brief Przesuwa wszystkie stany o zadany czas
+     * @param deltaTime Czas (w sekundach) od ostatniej aktualizacji
+     */
+    void update(float deltaTime);
+
+    const AnimationLodStats& getLodStats() const { return lodStats; }
+
+    /**
+     * @brief Zapisuje liczniki LOD w statystykach silnika (anim.*)
+     * @param stats Statystyki silnika
+     *
+     * Liczniki anim.on_demand i anim.events obejmują okres od poprzedniego
+     * raportu i są po zapisie zerowane.
+     */
+    void reportStats(EngineStats& stats);
+
+    /**
+     * @brief Pobiera kopię stanu odtwarzania
+     */
+    AnimationState getState(AnimationHandle handle) const;
+
+    /**
+     * @brief Pobiera prostokąt źródłowy aktualnej klatki
+     * @return Wskaźnik na prostokąt lub nullptr, jeśli stan nie ma klipu
+     *
+     * Nieaktualna klatka (LOD) jest wyznaczana w tym miejscu.
+     */
+    const AnimationSourceRect* getSourceRect(AnimationHandle handle);
+
+    /**
+     * @brief Pobiera poziom szczegółowości stanu z ostatniej aktualizacji
+     */
+    AnimationLod getLod(AnimationHandle handle) const {
+        uint32_t index = indexOf(handle);
+        return index == INVALID_ANIMATION_HANDLE ? AnimationLod::FULL : lods[index];
+    }
+
+    size_t getStateCount() const { return times.size(); }
+};
+
+#endif // ANIMATION_SYSTEM_H
@@ -0,0 +1,118 @@
+﻿/**
+ * @file Bounds.h
+ * @brief Bryły otaczające: prostokąt wyrównany do osi (AABB) i okrąg otaczający
+ *
+ * Bryły otaczające służą do taniego odrzucania par obiektów przed
+ * dokładnym (kosztownym) testem kształtów. Test AABB to cztery porównania,
+ * test okręgów - jedno mnożenie bez pierwiastka.
+ */
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include "Vec2.h"
+
+ /**
+  * @brief Prostokąt wyrównany do osi układu
+  */
+struct AABB {
+    Vec2 min;  ///< Lewy górny narożnik (najmniejsze współrzędne)
+    Vec2 max;  ///< Prawy dolny narożnik (największe współrzędne)
+
+    /**
+     * @brief Tworzy pusty prostokąt (min > max), neutralny dla expand/merge
+     */
+    AABB() : min(FLT_MAX, FLT_MAX), max(-FLT_MAX, -FLT_MAX) {}
+    AABB(const Vec2& min, const Vec2& max) : min(min), max(max) {}
+
+    /**
+     * @brief Prostokąt o zadanym środku i połowach wymiarów
+     */
+    static AABB fromCenter(const Vec2& center, const Vec2& halfExtents) {
+        return AABB(center - halfExtents, center + halfExtents);
+    }
+
+    /**
+     * @brief Najmniejszy prostokąt obejmujący zadane punkty
+     */
+    static AABB fromPoints(const Vec2* points, size_t count) {
+        AABB result;
+        for (size_t i = 0; i < count; i++) {
+            result.expand(points[i]);
+        }
+        return result;
+    }
+
+    bool isEmpty() const { return min.x > max.x || min.y > max.y; }
+    Vec2 getCenter() const { return (min + max) * 0.5f; }
+    Vec2 getHalfExtents() const { return (max - min) * 0.5f; }
+    float getWidth() const { return max.x - min.x; }
+    float getHeight() const { return max.y - min.y; }
+
+    /**
+     * @brief Rozszerza prostokąt tak, aby obejmował punkt
+     */
+    void expand(const Vec2& point) {
+        min.x = std::min(min.x, point.x);
+        min.y = std::min(min.y, point.y);
+        max.x = std::max(max.x, point.x);
+        max.y = std::max(max.y, point.y);
+    }
+
+    /**
+     * @brief Rozszerza prostokąt o margines z każdej strony
+     */
+    AABB inflated(float margin) const {
+        return AABB(Vec2(min.x - margin, min.y - margin), Vec2(max.x + margin, max.y + margin));
+    }
+
+    /**
+     * @brief Sprawdza, czy prostokąty się nakładają (styk krawędzi się liczy)
+     */
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+            min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    bool contains(const Vec2& point) const {
+        return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y;
+    }
+
+    /**
+     * @brief Suma dwóch prostokątów
+     */
+    static AABB merge(const AABB& a, const AABB& b) {
+        return AABB(Vec2(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)),
+            Vec2(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y)));
+    }
+};
+
+/**
+ * @brief Okrąg otaczający
+ */
+struct BoundingCircle {
+    Vec2 center;   ///< Środek
+    float radius;  ///< Promień
+
+    BoundingCircle() : center(), radius(0.0f) {}
+    BoundingCircle(const Vec2& center, float radius) : center(center), radius(radius) {}
+
+    bool overlaps(const BoundingCircle& other) const {
+        float reach = radius + other.radius;
+        return distanceSquared(center, other.center) <= reach * reach;
+    }
+
+    bool contains(const Vec2& point) const {
+        return distanceSquared(center, point) <= radius * radius;
+    }
+
+    /**
+     * @brief Prostokąt otaczający okrąg
+     */
+    AABB toAABB() const { return AABB::fromCenter(center, Vec2(radius, radius)); }
+};
+
+#endif // BOUNDS_H
@@ -0,0 +1,186 @@
+﻿#include "Curve.h"
+#include <algorithm>
+#include <cmath>
+
+Curve::Curve(Type type, const std::vector<Point2D>& controlPoints, bool closed, bool filled)
+    : type(type)
+    , controlPoints(controlPoints)
+    , closed(closed)
+    , filled(filled)
+    , pixelTolerance(0.25f)
+    , cachedBucket(0)
+    , dirty(true)
+    , tessellationCount(0)
+{
+}
+
+int Curve::scaleBucket(float scale) {
+    if (!(scale > 0.0f)) {
+        scale = 1.0f;
+    }
+    return static_cast<int>(std::floor(std::log2(scale) * 4.0f));
+}
+
+const std::vector<Point2D>& Curve::getFlattened(float scale) const {
+    int bucket = scaleBucket(scale);
+    if (dirty || bucket != cachedBucket) {
+        // Tolerancja liczona dla największej skali przedziału - przy każdej skali
+        // z tego przedziału odchylenie na ekranie nie przekracza pixelTolerance
+        tessellate(std::exp2((bucket + 1) / 4.0f));
+        cachedBucket = bucket;
+        dirty = false;
+    }
+    return flattened;
+}
+
+size_t Curve::getSegmentCount() const {
+    size_t count = controlPoints.size();
+    switch (type) {
+    case Type::QUADRATIC_BEZIER:
+        return count >= 3 ? (count - 1) / 2 : 0;
+    case Type::CUBIC_BEZIER:
+        return count >= 4 ? (count - 1) / 3 : 0;
+    case Type::CATMULL_ROM:
+        if (count < 2) return 0;
+        return closed ? count : count - 1;
+    }
+    return 0;
+}
+
+// Każdy segment jest sprowadzany do krzywej sześciennej Béziera (b0..b3)
+void Curve::getSegment(size_t index, Vec2& b0, Vec2& b1, Vec2& b2, Vec2& b3) const {
+    switch (type) {
+    case Type::QUADRATIC_BEZIER: {
+        // Podniesienie stopnia: punkty pośrednie w 2/3 drogi do punktu kontrolnego
+        Vec2 p0 = controlPoints[index * 2].toVec2();
+        Vec2 p1 = controlPoints[index * 2 + 1].toVec2();
+        Vec2 p2 = controlPoints[index * 2 + 2].toVec2();
+        b0 = p0;
+        b1 = p0 + (p1 - p0) * (2.0f / 3.0f);
+        b2 = p2 + (p1 - p2) * (2.0f / 3.0f);
+        b3 = p2;
+        break;
+    }
+    case Type::CUBIC_BEZIER:
+        b0 = controlPoints[index * 3].toVec2();
+        b1 = controlPoints[index * 3 + 1].toVec2();
+        b2 = controlPoints[index * 3 + 2].toVec2();
+        b3 = controlPoints[index * 3 + 3].toVec2();
+        break;
+    case Type::CATMULL_ROM: {
+        // Splajn jednorodny: styczne (p2 - p0) / 2, czyli punkty Béziera w 1/6 różnicy
+        size_t count = controlPoints.size();
+        auto at = [this, count](long i) {
+            if (closed) {
+                long n = static_cast<long>(count);
+                return controlPoints[static_cast<size_t>(((i % n) + n) % n)].toVec2();
+            }
+            long last = static_cast<long>(count) - 1;
+            return controlPoints[static_cast<size_t>(std::max(0L, std::min(i, last)))].toVec2();
+        };
+        long i = static_cast<long>(index);
+        Vec2 p0 = at(i - 1);
+        Vec2 p1 = at(i);
+        Vec2 p2 = at(i + 1);
+        Vec2 p3 = at(i + 2);
+        b0 = p1;
+        b1 = p1 + (p2 - p0) / 6.0f;
+        b2 = p2 - (p3 - p1) / 6.0f;
+        b3 = p2;
+        break;
+    }
+    }
+}
+
+void Curve::tessellate(float scale) const {
+    flattened.clear();
+    tessellationCount++;
+
+    size_t segments = getSegmentCount();
+    if (segments == 0) {
+        flattened.assign(controlPoints.begin(), controlPoints.end());
+        return;
+    }
+
+    // Kryterium płaskości porównuje kwadraty odchyleń pomnożone przez 16
+    float tolerance = pixelTolerance / scale;
+    float toleranceSquared = 16.0f * tolerance * tolerance;
+
+    Vec2 b0, b1, b2, b3;
+    getSegment(0, b0, b1, b2, b3);
+    flattened.push_back(b0);
+    for (size_t i = 0; i < segments; i++) {
+        getSegment(i, b0, b1, b2, b3);
+        flattenCubic(b0, b1, b2, b3, toleranceSquared, 0);
+    }
+
+    // Krzywa zamknięta jest rysowana z odcinkiem od ostatniego do pierwszego punktu
+    if (closed && flattened.size() > 1) {
+        const Point2D& first = flattened.front();
+        const Point2D& last = flattened.back();
+        if (first.getX() == last.getX() && first.getY() == last.getY()) {
+            flattened.pop_back();
+        }
+    }
+}
+
+void Curve::flattenCubic(const Vec2& p0, const Vec2& p1, const Vec2& p2, const Vec2& p3,
+    float toleranceSquared, int depth) const {
+    // Odchylenie punktów kontrolnych od prostej (kryterium Willcocksa)
+    float ux = 3.0f * p1.x - 2.0f * p0.x - p3.x;
+    float uy = 3.0f * p1.y - 2.0f * p0.y - p3.y;
+    float vx = 3.0f * p2.x - p0.x - 2.0f * p3.x;
+    float vy = 3.0f * p2.y - p0.y - 2.0f * p3.y;
+    float flatness = std::max(ux * ux, vx * vx) + std::max(uy * uy, vy * vy);
+
+    if (flatness <= toleranceSquared || depth >= MAX_DEPTH) {
+        flattened.push_back(p3);
+        return;
+    }
+
+    // Podział de Casteljau w połowie parametru
+    Vec2 p01 = (p0 + p1) * 0.5f;
+    Vec2 p12 = (p1 + p2) * 0.5f;
+    Vec2 p23 = (p2 + p3) * 0.5f;
+    Vec2 p012 = (p01 + p12) * 0.5f;
+    Vec2 p123 = (p12 + p23) * 0.5f;
+    Vec2 mid = (p012 + p123) * 0.5f;
+
+    flattenCubic(p0, p01, p012, mid, toleranceSquared, depth + 1);
+    flattenCubic(mid, p123, p23, p3, toleranceSquared, depth + 1);
+}
+
+void Curve::setControlPoint(size_t index, const Point2D& point) {
+    if (index < controlPoints.size()) {
+        controlPoints[index] = point;
+        dirty = true;
+    }
+}
+
+void Curve::setControlPoints(const std::vector<Point2D>& points) {
+    controlPoints = points;
+    dirty = true;
+}
+
+void Curve::setClosed(bool isClosed) {
+    if (closed != isClosed) {
+        closed = isClosed;
+        dirty = true;
+    }
+}
+
+void Curve::setPixelTolerance(float tolerance) {
+    pixelTolerance = tolerance > 0.01f ? tolerance : 0.01f;
+    dirty = true;
+}
+
+void Curve::translate(float dx, float dy) {
+    for (Point2D& point : controlPoints) {
+        point.translate(dx, dy);
+    }
+    if (!dirty) {
+        for (Point2D& point : flattened) {
+            point.translate(dx, dy);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+﻿/**
+ * @file Curve.h
+ * @brief Krzywe Béziera (kwadratowe i sześcienne) oraz splajny Catmulla-Roma
+ *
+ * Krzywa jest przed rysowaniem zamieniana na łamaną (spłaszczana).
+ * Podział jest adaptacyjny: odcinek krzywej dzielony jest tylko tam,
+ * gdzie odchylenie od cięciwy przekracza tolerancję w pikselach przy
+ * aktualnej skali kamery. Wynik jest buforowany w krzywej i liczony
+ * ponownie dopiero po zmianie punktów kontrolnych lub przedziału skali
+ * (co ćwierć oktawy), więc nieruchoma krzywa nie jest dzielona
+ * w każdej klatce.
+ */
+
+#ifndef CURVE_H
+#define CURVE_H
+
+#include <cstddef>
+#include <vector>
+#include "Primitives.h"
+
+ /**
+  * @brief Krzywa parametryczna spłaszczana do łamanej
+  */
+class Curve {
+public:
+    /**
+     * @brief Rodzaj krzywej
+     */
+    enum class Type {
+        QUADRATIC_BEZIER,  ///< Łańcuch krzywych kwadratowych (1 + 2k punktów)
+        CUBIC_BEZIER,      ///< Łańcuch krzywych sześciennych (1 + 3k punktów)
+        CATMULL_ROM        ///< Splajn przechodzący przez wszystkie punkty (min. 2)
+    };
+
+private:
+    Type type;                              ///< Rodzaj krzywej
+    std::vector<Point2D> controlPoints;     ///< Punkty kontrolne
+    bool closed;                            ///< Czy krzywa jest zamknięta
+    bool filled;                            ///< Czy wypełniać wnętrze (krzywa zamknięta)
+    float pixelTolerance;                   ///< Dopuszczalne odchylenie łamanej w pikselach
+
+    mutable std::vector<Point2D> flattened; ///< Zbuforowana łamana
+    mutable int cachedBucket;               ///< Przedział skali zbuforowanej łamanej
+    mutable bool dirty;                     ///< Czy punkty kontrolne zmieniły się od spłaszczenia
+    mutable unsigned tessellationCount;     ///< Liczba spłaszczeń (diagnostyka bufora)
+
+    static const int MAX_DEPTH = 16;        ///< Maksymalna głębokość podziału segmentu
+
+    void tessellate(float scale) const;
+    void flattenCubic(const Vec2& p0, const Vec2& p1, const Vec2& p2, const Vec2& p3,
+        float toleranceSquared, int depth) const;
+    size_t getSegmentCount() const;
+    void getSegment(size_t index, Vec2& b0, Vec2& b1, Vec2& b2, Vec2& b3) const;
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param type Rodzaj krzywej
+     * @param controlPoints Punkty kontrolne
+     * @param closed Czy krzywa jest zamknięta (ostatni punkt łączy się z pierwszym)
+     * @param filled Czy wypełniać wnętrze
+     */
+    Curve(Type type, const std::vector<Point2D>& controlPoints, bool closed = false, bool filled = false);
+
+    /**
+     * @brief Pobiera łamaną dla zadanej skali (z bufora, jeśli aktualny)
+     * @param scale Liczba pikseli na jednostkę świata (zoom kamery * skala renderowania)
+     * @return Punkty łamanej w układzie świata
+     */
+    const std::vector<Point2D>& getFlattened(float scale = 1.0f) const;
+
+    /**
+     * @brief Wyznacza przedział skali (ćwierć oktawy) używany jako klucz bufora
+     */
+    static int scaleBucket(float scale);
+
+    Type getType() const { return type; }
+    const std::vector<Point2D>& getControlPoints() const { return controlPoints; }
+    bool isClosed() const { return closed; }
+    bool isFilled() const { return filled; }
+    float getPixelTolerance() const { return pixelTolerance; }
+    unsigned getTessellationCount() const { return tessellationCount; }
+
+    void setControlPoint(size_t index, const Point2D& point);
+    void setControlPoints(const std::vector<Point2D>& points);
+    void setClosed(bool isClosed);
+    void setFilled(bool fill) { filled = fill; }
+    void setPixelTolerance(float tolerance);
+
+    /**
+     * @brief Przesuwa krzywą (bufor łamanej jest przesuwany bez ponownego podziału)
+     */
+    void translate(float dx, float dy);
+};
+
+#endif // CURVE_H
@@ -0,0 +1,70 @@
+﻿#include "EngineStats.h"
+#include <cstdio>
+
+// ScopedTimer
+EngineStats::ScopedTimer::ScopedTimer(EngineStats& stats, const char* name)
+    : stats(stats)
+    , name(name)
+    , start(std::chrono::steady_clock::now())
+{
+}
+
+EngineStats::ScopedTimer::~ScopedTimer() {
+    auto end = std::chrono::steady_clock::now();
+    stats.addTime(name, std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+// EngineStats
+EngineStats::EngineStats()
+    : frame(0)
+    , smoothing(0.1)
+{
+}
+
+void EngineStats::beginFrame() {
+    for (auto& pair : sections) {
+        Section& section = pair.second;
+        section.lastMs = section.accumulatedMs;
+        section.averageMs = section.samples == 0
+            ? section.lastMs
+            : section.averageMs + (section.lastMs - section.averageMs) * smoothing;
+        section.accumulatedMs = 0.0;
+        section.samples++;
+    }
+
+    lastCounters.swap(counters);
+    counters.clear();
+    frame++;
+}
+
+void EngineStats::addTime(const std::string& name, double milliseconds) {
+    sections[name].accumulatedMs += milliseconds;
+}
+
+void EngineStats::addCounter(const std::string& name, long amount) {
+    counters[name] += amount;
+}
+
+void EngineStats::setCounter(const std::string& name, long value) {
+    counters[name] = value;
+}
+
+EngineStats::Section EngineStats::getSection(const std::string& name) const {
+    auto it = sections.find(name);
+    return it != sections.end() ? it->second : Section();
+}
+
+long EngineStats::getCounter(const std::string& name) const {
+    auto it = lastCounters.find(name);
+    return it != lastCounters.end() ? it->second : 0;
+}
+
+std::string EngineStats::summary() const {
+    std::string text;
+    char line[128];
+    for (const auto& pair : sections) {
+        snprintf(line, sizeof(line), "%s: %.2f ms\n", pair.first.c_str(), pair.second.averageMs);
+        text += line;
+    }
+    return text;
+}
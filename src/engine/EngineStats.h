@@ -0,0 +1,122 @@
+﻿/**
+ * @file EngineStats.h
+ * @brief Statystyki silnika - czasy sekcji klatki i liczniki
+ *
+ * EngineStats zbiera czasy nazwanych sekcji (aktualizacja, renderowanie,
+ * przebiegi post-processingu itp.) oraz liczniki zdarzeń z bieżącej klatki.
+ * Czasy są uśredniane wykładniczo, aby odczyty były stabilne.
+ */
+
+#ifndef ENGINE_STATS_H
+#define ENGINE_STATS_H
+
+#include <chrono>
+#include <map>
+#include <string>
+
+ /**
+  * @brief Zbiór czasów sekcji i liczników silnika
+  */
+class EngineStats {
+public:
+    /**
+     * @brief Statystyka pojedynczej sekcji czasowej
+     */
+    struct Section {
+        double lastMs;         ///< Czas z ostatniej klatki (suma wywołań)
+        double averageMs;      ///< Średnia wykładnicza czasu
+        double accumulatedMs;  ///< Czas zebrany w bieżącej klatce
+        unsigned long samples; ///< Liczba zamkniętych klatek z pomiarem
+
+        Section() : lastMs(0.0), averageMs(0.0), accumulatedMs(0.0), samples(0) {}
+    };
+
+    /**
+     * @brief Mierzy czas od utworzenia do zniszczenia obiektu
+     *
+     * Przykład: { EngineStats::ScopedTimer t(stats, "post.blur"); ... }
+     */
+    class ScopedTimer {
+    private:
+        EngineStats& stats;
+        const char* name;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        ScopedTimer(EngineStats& stats, const char* name);
+        ~ScopedTimer();
+    };
+
+private:
+    std::map<std::string, Section> sections;   ///< Sekcje czasowe według nazwy
+    std::map<std::string, long> counters;      ///< Liczniki bieżącej klatki
+    std::map<std::string, long> lastCounters;  ///< Liczniki z poprzedniej klatki
+    unsigned long frame;                       ///< Numer bieżącej klatki
+    double smoothing;                          ///< Waga nowej próbki w średniej (0-1)
+
+public:
+    EngineStats();
+
+    /**
+     * @brief Zamyka bieżącą klatkę i rozpoczyna następną
+     *
+     * Czas zebrany w każdej sekcji staje się wartością lastMs i trafia
+     * do średniej, a liczniki są przenoszone do lastCounters.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Dodaje pomiar czasu do sekcji bieżącej klatki
+     * @param name Nazwa sekcji
+     * @param milliseconds Czas w milisekundach
+     */
+    void addTime(const std::string& name, double milliseconds);
+
+    /**
+     * @brief Zwiększa licznik bieżącej klatki
+     * @param name Nazwa licznika
+     * @param amount Wartość do dodania
+     */
+    void addCounter(const std::string& name, long amount = 1);
+
+    /**
+     * @brief Ustawia wartość licznika bieżącej klatki
+     * @param name Nazwa licznika
+     * @param value Nowa wartość
+     */
+    void setCounter(const std::string& name, long value);
+
+    /**
+     * @brief Pobiera statystykę sekcji
+     * @param name Nazwa sekcji
+     * @return Sekcja lub pusta sekcja gdy nie było pomiarów
+     */
+    Section getSection(const std::string& name) const;
+
+    /**
+     * @brief Pobiera wartość licznika z ostatniej zamkniętej klatki
+     * @param name Nazwa licznika
+     * @return Wartość licznika (0 gdy brak)
+     */
+    long getCounter(const std::string& name) const;
+
+    /**
+     * @brief Pobiera wszystkie sekcje
+     * @return Mapa sekcji według nazwy
+     */
+    const std::map<std::string, Section>& getSections() const { return sections; }
+
+    /**
+     * @brief Pobiera numer bieżącej klatki
+     * @return Numer klatki
+     */
+    unsigned long getFrame() const { return frame; }
+
+    /**
+     * @brief Tworzy czytelne podsumowanie średnich czasów sekcji
+     * @return Tekst w formacie "sekcja: x.xx ms" (jedna sekcja w wierszu)
+     */
+    std::string summary() const;
+};
+
+#endif // ENGINE_STATS_H
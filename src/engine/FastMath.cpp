@@ -0,0 +1,123 @@
+﻿#include "FastMath.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define FAST_MATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace FastMath {
+
+#ifdef FAST_MATH_SSE2
+    namespace {
+        inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        inline __m128 madd(__m128 a, __m128 b, __m128 c) {
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+        }
+    }
+#endif
+
+    void sincos(const float* angles, float* sinOut, float* cosOut, size_t count, Precision precision) {
+        size_t i = 0;
+
+#ifdef FAST_MATH_SSE2
+        const bool high = precision == Precision::HIGH;
+        const __m128 twoOverPi = _mm_set1_ps(TWO_OVER_PI_F);
+        const __m128 pio2Hi = _mm_set1_ps(PIO2_HI);
+        const __m128 pio2Mid = _mm_set1_ps(PIO2_MID);
+        const __m128 pio2Lo = _mm_set1_ps(PIO2_LO);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128i intOne = _mm_set1_epi32(1);
+        const __m128i intTwo = _mm_set1_epi32(2);
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_loadu_ps(angles + i);
+            // _mm_cvtps_epi32 zaokrągla do najbliższej (domyślny tryb MXCSR)
+            __m128i k = _mm_cvtps_epi32(_mm_mul_ps(x, twoOverPi));
+            __m128 kf = _mm_cvtepi32_ps(k);
+            __m128 r = _mm_sub_ps(x, _mm_mul_ps(kf, pio2Hi));
+            r = _mm_sub_ps(r, _mm_mul_ps(kf, pio2Mid));
+            r = _mm_sub_ps(r, _mm_mul_ps(kf, pio2Lo));
+            __m128 r2 = _mm_mul_ps(r, r);
+
+            __m128 ps, pc;
+            if (high) {
+                ps = madd(r2, _mm_set1_ps(2.7557319e-6f), _mm_set1_ps(-1.9841270e-4f));
+                ps = madd(r2, ps, _mm_set1_ps(8.3333338e-3f));
+                ps = madd(r2, ps, _mm_set1_ps(-1.6666667e-1f));
+                pc = madd(r2, _mm_set1_ps(-2.7557319e-7f), _mm_set1_ps(2.4801587e-5f));
+                pc = madd(r2, pc, _mm_set1_ps(-1.3888889e-3f));
+                pc = madd(r2, pc, _mm_set1_ps(4.1666668e-2f));
+            }
+            else {
+                ps = madd(r2, _mm_set1_ps(8.3333338e-3f), _mm_set1_ps(-1.6666667e-1f));
+                pc = madd(r2, _mm_set1_ps(-1.3888889e-3f), _mm_set1_ps(4.1666668e-2f));
+            }
+            ps = madd(_mm_mul_ps(r, r2), ps, r);
+            pc = madd(r2, madd(r2, pc, _mm_set1_ps(-0.5f)), one);
+
+            // Ćwiartka: bit 0 zamienia sin i cos, bit 1 zmienia znak
+            __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, intOne), intOne));
+            __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, intTwo), 30));
+            __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, intOne), intTwo), 30));
+
+            _mm_storeu_ps(sinOut + i, _mm_xor_ps(select(swap, pc, ps), sinSign));
+            _mm_storeu_ps(cosOut + i, _mm_xor_ps(select(swap, ps, pc), cosSign));
+        }
+#endif
+        for (; i < count; i++) {
+            sincos(angles[i], sinOut[i], cosOut[i], precision);
+        }
+    }
+
+    void atan2(const float* ys, const float* xs, float* out, size_t count, Precision precision) {
+        size_t i = 0;
+
+#ifdef FAST_MATH_SSE2
+        const bool high = precision == Precision::HIGH;
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 smallest = _mm_set1_ps(1e-30f);
+        const __m128 halfPi = _mm_set1_ps(HALF_PI_F);
+        const __m128 pi = _mm_set1_ps(PI_F);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= count; i += 4) {
+            __m128 y = _mm_loadu_ps(ys + i);
+            __m128 x = _mm_loadu_ps(xs + i);
+            __m128 ax = _mm_andnot_ps(signMask, x);
+            __m128 ay = _mm_andnot_ps(signMask, y);
+            __m128 mx = _mm_max_ps(ax, ay);
+            __m128 mn = _mm_min_ps(ax, ay);
+            // Dla wektora zerowego 0 / 1e-30 = 0, więc wynik też wynosi 0
+            __m128 a = _mm_div_ps(mn, _mm_max_ps(mx, smallest));
+            __m128 s = _mm_mul_ps(a, a);
+
+            __m128 p;
+            if (high) {
+                p = madd(s, _mm_set1_ps(-4.054483958e-03f), _mm_set1_ps(2.186267078e-02f));
+                p = madd(s, p, _mm_set1_ps(-5.591193587e-02f));
+                p = madd(s, p, _mm_set1_ps(9.642170370e-02f));
+                p = madd(s, p, _mm_set1_ps(-1.390862018e-01f));
+                p = madd(s, p, _mm_set1_ps(1.994656324e-01f));
+                p = madd(s, p, _mm_set1_ps(-3.332985938e-01f));
+                p = madd(s, p, _mm_set1_ps(9.999993443e-01f));
+            }
+            else {
+                p = madd(s, _mm_set1_ps(2.084532008e-02f), _mm_set1_ps(-8.515676856e-02f));
+                p = madd(s, p, _mm_set1_ps(1.801595688e-01f));
+                p = madd(s, p, _mm_set1_ps(-3.303048611e-01f));
+                p = madd(s, p, _mm_set1_ps(9.998663068e-01f));
+            }
+            __m128 r = _mm_mul_ps(a, p);
+
+            r = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(halfPi, r), r);
+            r = select(_mm_cmplt_ps(x, zero), _mm_sub_ps(pi, r), r);
+            r = select(_mm_cmplt_ps(y, zero), _mm_xor_ps(r, signMask), r);
+            _mm_storeu_ps(out + i, r);
+        }
+#endif
+        for (; i < count; i++) {
+            out[i] = atan2(ys[i], xs[i], precision);
+        }
+    }
+}
@@ -0,0 +1,176 @@
+﻿/**
+ * @file FastMath.h
+ * @brief Szybkie przybliżenia funkcji trygonometrycznych dla gorących pętli
+ *
+ * sincos liczy sinus i cosinus jednego kąta wspólną redukcją do przedziału
+ * [-PI/4, PI/4] i dwoma wielomianami, atan2 - wielomianem minimaksowym
+ * na [0, 1] z odbiciami ćwiartek. Funkcje skalarne są zdefiniowane
+ * w nagłówku (rozwijane w miejscu wywołania), wersje wsadowe dla tablic
+ * SoA mają ścieżkę SSE (FastMath.cpp).
+ *
+ * Dokładność wybiera się parametrem Precision. Gwarantowane maksymalne
+ * błędy bezwzględne dla |kąt| <= 1000 zwraca maxError(); sprawdza je
+ * benchmark uruchamiany parametrem --math-bench.
+ */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "Vec2.h"
+
+namespace FastMath {
+
+    /**
+     * @brief Poziom dokładności przybliżeń
+     */
+    enum class Precision {
+        LOW,   ///< Krótsze wielomiany - wystarczające dla kierunków ruchu i efektów
+        HIGH   ///< Błąd bliski dokładności float
+    };
+
+    /**
+     * @brief Funkcja, której dotyczy ograniczenie błędu
+     */
+    enum class Function {
+        SINCOS,
+        ATAN2
+    };
+
+    /**
+     * @brief Maksymalny błąd bezwzględny przybliżenia (w radianach dla atan2)
+     */
+    inline float maxError(Function function, Precision precision) {
+        if (function == Function::SINCOS) {
+            return precision == Precision::HIGH ? 5e-7f : 5e-5f;
+        }
+        return precision == Precision::HIGH ? 5e-7f : 2e-5f;
+    }
+
+    const float PI_F = 3.14159265358979f;
+    const float HALF_PI_F = 1.57079632679490f;
+    const float TWO_OVER_PI_F = 0.636619772367581f;
+
+    // PI/2 rozbite na trzy części o krótkich mantysach (redukcja Cody'ego-Waite'a) -
+    // iloczyny k * PIO2_HI i k * PIO2_MID są dokładne dla |k| < 2^15
+    const float PIO2_HI = 1.5703125f;
+    const float PIO2_MID = 4.837512969970703125e-4f;
+    const float PIO2_LO = 7.54978995489188216e-8f;
+
+    /**
+     * @brief Sinus i cosinus kąta z jedną wspólną redukcją argumentu
+     * @param angle Kąt w radianach
+     * @param s Sinus (wynik)
+     * @param c Cosinus (wynik)
+     * @param precision Dokładność
+     */
+    inline void sincos(float angle, float& s, float& c, Precision precision = Precision::HIGH) {
+        // Zaokrąglenie przez obcięcie z przesunięciem o 0.5 w stronę znaku (bez wywołania floor)
+        float scaled = angle * TWO_OVER_PI_F;
+        int quadrant = static_cast<int>(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+        float k = static_cast<float>(quadrant);
+        float r = ((angle - k * PIO2_HI) - k * PIO2_MID) - k * PIO2_LO;
+        float r2 = r * r;
+
+        float ps, pc;
+        if (precision == Precision::HIGH) {
+            ps = r + r * r2 * (-1.6666667e-1f + r2 * (8.3333338e-3f + r2 * (-1.9841270e-4f + r2 * 2.7557319e-6f)));
+            pc = 1.0f + r2 * (-0.5f + r2 * (4.1666668e-2f + r2 * (-1.3888889e-3f + r2 * (2.4801587e-5f + r2 * -2.7557319e-7f))));
+        }
+        else {
+            ps = r + r * r2 * (-1.6666667e-1f + r2 * 8.3333338e-3f);
+            pc = 1.0f + r2 * (-0.5f + r2 * (4.1666668e-2f + r2 * -1.3888889e-3f));
+        }
+
+        // Ćwiartka wybierana na bitach (bez skoków, które przy losowych kątach są źle
+        // przewidywane): bit 0 zamienia sin i cos, bit 1 zmienia znak
+        uint32_t sinBits, cosBits;
+        std::memcpy(&sinBits, &ps, sizeof(float));
+        std::memcpy(&cosBits, &pc, sizeof(float));
+        uint32_t swapMask = 0u - static_cast<uint32_t>(quadrant & 1);
+        uint32_t resultSin = (sinBits & ~swapMask) | (cosBits & swapMask);
+        uint32_t resultCos = (cosBits & ~swapMask) | (sinBits & swapMask);
+        resultSin ^= static_cast<uint32_t>(quadrant & 2) << 30;
+        resultCos ^= static_cast<uint32_t>((quadrant + 1) & 2) << 30;
+        std::memcpy(&s, &resultSin, sizeof(float));
+        std::memcpy(&c, &resultCos, sizeof(float));
+    }
+
+    inline float sin(float angle, Precision precision = Precision::HIGH) {
+        float s, c;
+        sincos(angle, s, c, precision);
+        return s;
+    }
+
+    inline float cos(float angle, Precision precision = Precision::HIGH) {
+        float s, c;
+        sincos(angle, s, c, precision);
+        return c;
+    }
+
+    /**
+     * @brief Wektor jednostkowy o zadanym kącie
+     */
+    inline Vec2 direction(float angle, Precision precision = Precision::HIGH) {
+        float s, c;
+        sincos(angle, s, c, precision);
+        return Vec2(c, s);
+    }
+
+    /**
+     * @brief Arcus tangens na przedziale [0, 1]
+     */
+    inline float atanUnit(float a, Precision precision = Precision::HIGH) {
+        float s = a * a;
+        if (precision == Precision::HIGH) {
+            return a * (9.999993443e-01f + s * (-3.332985938e-01f + s * (1.994656324e-01f + s * (-1.390862018e-01f
+                + s * (9.642170370e-02f + s * (-5.591193587e-02f + s * (2.186267078e-02f + s * -4.054483958e-03f)))))));
+        }
+        return a * (9.998663068e-01f + s * (-3.303048611e-01f + s * (1.801595688e-01f
+            + s * (-8.515676856e-02f + s * 2.084532008e-02f))));
+    }
+
+    /**
+     * @brief Kąt wektora (y, x) w radianach z zakresu [-PI, PI]
+     * @return Kąt lub 0 dla wektora zerowego
+     */
+    inline float atan2(float y, float x, Precision precision = Precision::HIGH) {
+        float ax = std::fabs(x);
+        float ay = std::fabs(y);
+        float mx = ax > ay ? ax : ay;
+        float mn = ax > ay ? ay : ax;
+        if (mx == 0.0f) {
+            return 0.0f;
+        }
+
+        float r = atanUnit(mn / mx, precision);
+        if (ay > ax) r = HALF_PI_F - r;
+        if (x < 0.0f) r = PI_F - r;
+        return y < 0.0f ? -r : r;
+    }
+
+    /**
+     * @brief Wsadowe sincos dla tablicy kątów (SoA)
+     * @param angles Kąty w radianach
+     * @param sinOut Tablica sinusów
+     * @param cosOut Tablica cosinusów
+     * @param count Liczba elementów
+     * @param precision Dokładność
+     */
+    void sincos(const float* angles, float* sinOut, float* cosOut, size_t count, Precision precision = Precision::HIGH);
+
+    /**
+     * @brief Wsadowe atan2 dla tablic składowych (SoA)
+     * @param ys Składowe Y
+     * @param xs Składowe X
+     * @param out Tablica kątów
+     * @param count Liczba elementów
+     * @param precision Dokładność
+     */
+    void atan2(const float* ys, const float* xs, float* out, size_t count, Precision precision = Precision::HIGH);
+}
+
+#endif // FAST_MATH_H
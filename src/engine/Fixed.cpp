@@ -0,0 +1,189 @@
+﻿#include "Fixed.h"
+
+namespace {
+    // CORDIC liczony w Q2.30 (int64), wynik zaokrąglany do Q16.16
+    const int CORDIC_BITS = 30;
+    const int CORDIC_ITERATIONS = 30;
+    const int SHIFT_TO_FIXED = CORDIC_BITS - Fixed::FRACTION_BITS;
+
+    // atan(2^-i) * 2^30
+    const int64_t ATAN_TABLE[CORDIC_ITERATIONS] = {
+        843314857, 497837829, 263043837, 133525159, 67021687, 33543516, 16775851, 8388437,
+        4194283, 2097149, 1048576, 524288, 262144, 131072, 65536, 32768,
+        16384, 8192, 4096, 2048, 1024, 512, 256, 128,
+        64, 32, 16, 8, 4, 2
+    };
+
+    // Odwrotność wzmocnienia CORDIC (iloczyn 1/sqrt(1 + 2^-2i)) * 2^30
+    const int64_t CORDIC_GAIN_INV = 652032874;
+    const int64_t HALF_PI_Q30 = 1686629713;
+
+    int32_t toFixedRaw(int64_t q30) {
+        return static_cast<int32_t>((q30 + (int64_t(1) << (SHIFT_TO_FIXED - 1))) >> SHIFT_TO_FIXED);
+    }
+}
+
+Fixed Fixed::sqrt(Fixed x) {
+    if (x.raw <= 0) {
+        return Fixed();
+    }
+
+    // sqrt(raw / 2^16) * 2^16 = sqrt(raw * 2^16)
+    return sqrtWide(static_cast<uint64_t>(x.raw) << FRACTION_BITS);
+}
+
+Fixed Fixed::sqrtWide(uint64_t rawQ32) {
+    // sqrt(raw / 2^32) * 2^16 = sqrt(raw) - pierwiastek całkowity, cyfra po cyfrze
+    uint64_t value = rawQ32;
+    uint64_t result = 0;
+    uint64_t bit = uint64_t(1) << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return fromRaw(result > static_cast<uint64_t>(INT32_MAX) ? INT32_MAX : static_cast<int32_t>(result));
+}
+
+Fixed Fixed::ratio(FixedWide num, FixedWide den) {
+    int64_t n = num.getRaw();
+    int64_t d = den.getRaw();
+    if (d == 0) {
+        return Fixed();
+    }
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+
+    // Przesunięcie licznika o 16 bitów musi zmieścić się w int64 - obie wartości
+    // skracane jednakowo (iloraz zachowany z dokładnością do dzielnika)
+    const int64_t LIMIT = int64_t(1) << 46;
+    while (n >= LIMIT || n <= -LIMIT) {
+        n /= 2;
+        d /= 2;
+    }
+    if (d == 0) {
+        return fromRaw(n < 0 ? INT32_MIN : INT32_MAX);
+    }
+
+    int64_t result = (n * ONE) / d;
+    if (result > INT32_MAX) return fromRaw(INT32_MAX);
+    if (result < INT32_MIN) return fromRaw(INT32_MIN);
+    return fromRaw(static_cast<int32_t>(result));
+}
+
+Fixed Fixed::length(Fixed x, Fixed y) {
+    // Każdy kwadrat mieści się w 2^62, więc suma nie przepełnia uint64
+    uint64_t xx = static_cast<uint64_t>(static_cast<int64_t>(x.raw) * x.raw);
+    uint64_t yy = static_cast<uint64_t>(static_cast<int64_t>(y.raw) * y.raw);
+    return sqrtWide(xx + yy);
+}
+
+void Fixed::sincos(Fixed angle, Fixed& sinOut, Fixed& cosOut) {
+    // Sprowadzenie kąta do [-PI, PI], a potem do [-PI/2, PI/2] (zbieżność CORDIC)
+    int32_t a = angle.raw % twoPi().raw;
+    if (a > pi().raw) a -= twoPi().raw;
+    else if (a < -pi().raw) a += twoPi().raw;
+
+    bool negate = false;
+    if (a > halfPi().raw) {
+        a -= pi().raw;
+        negate = true;
+    }
+    else if (a < -halfPi().raw) {
+        a += pi().raw;
+        negate = true;
+    }
+
+    int64_t x = CORDIC_GAIN_INV;
+    int64_t y = 0;
+    int64_t z = static_cast<int64_t>(a) << SHIFT_TO_FIXED;
+    for (int i = 0; i < CORDIC_ITERATIONS; i++) {
+        int64_t dx = y >> i;
+        int64_t dy = x >> i;
+        if (z >= 0) {
+            x -= dx;
+            y += dy;
+            z -= ATAN_TABLE[i];
+        }
+        else {
+            x += dx;
+            y -= dy;
+            z += ATAN_TABLE[i];
+        }
+    }
+
+    sinOut = fromRaw(toFixedRaw(negate ? -y : y));
+    cosOut = fromRaw(toFixedRaw(negate ? -x : x));
+}
+
+Fixed Fixed::sin(Fixed angle) {
+    Fixed s, c;
+    sincos(angle, s, c);
+    return s;
+}
+
+Fixed Fixed::cos(Fixed angle) {
+    Fixed s, c;
+    sincos(angle, s, c);
+    return c;
+}
+
+Fixed Fixed::atan2(Fixed y, Fixed x) {
+    if (x.raw == 0 && y.raw == 0) {
+        return Fixed();
+    }
+
+    int64_t vx = x.raw;
+    int64_t vy = y.raw;
+    int64_t z = 0;
+
+    // Obrót do prawej półpłaszczyzny
+    if (vx < 0) {
+        int64_t t = vx;
+        if (vy >= 0) {
+            vx = vy;
+            vy = -t;
+            z = HALF_PI_Q30;
+        }
+        else {
+            vx = -vy;
+            vy = t;
+            z = -HALF_PI_Q30;
+        }
+    }
+
+    // Normalizacja do ~2^30 dla pełnej dokładności (kąt nie zależy od długości)
+    int64_t magnitude = (vx > (vy < 0 ? -vy : vy)) ? vx : (vy < 0 ? -vy : vy);
+    while (magnitude < (int64_t(1) << 29)) {
+        vx <<= 1;
+        vy <<= 1;
+        magnitude <<= 1;
+    }
+
+    for (int i = 0; i < CORDIC_ITERATIONS; i++) {
+        int64_t dx = vy >> i;
+        int64_t dy = vx >> i;
+        if (vy > 0) {
+            vx += dx;
+            vy -= dy;
+            z += ATAN_TABLE[i];
+        }
+        else {
+            vx -= dx;
+            vy += dy;
+            z -= ATAN_TABLE[i];
+        }
+    }
+
+    return fromRaw(toFixedRaw(z));
+}
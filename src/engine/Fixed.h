@@ -0,0 +1,156 @@
+﻿/**
+ * @file Fixed.h
+ * @brief Liczba stałoprzecinkowa Q16.16 z deterministyczną trygonometrią
+ *
+ * Wszystkie operacje (także sqrt, sin, cos i atan2) są wykonywane wyłącznie
+ * na liczbach całkowitych, więc dają identyczne bity na każdym kompilatorze
+ * i procesorze. Zakres wartości to [-32768, 32768) z krokiem 1/65536.
+ * Iloczyny (np. kwadraty odległości) przekraczające ten zakres są liczone
+ * jako FixedWide (Q32.32 w int64).
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cmath>
+#include <cstdint>
+
+ /**
+  * @brief Iloczyn dwóch liczb Q16.16 w formacie Q32.32
+  *
+  * Służy do porównań kwadratów odległości, iloczynów skalarnych
+  * i wektorowych. Dla współrzędnych z zakresu [-16384, 16384) suma dwóch
+  * iloczynów różnic mieści się w int64.
+  */
+class FixedWide {
+private:
+    int64_t raw;  ///< Wartość * 2^32
+
+public:
+    constexpr FixedWide() : raw(0) {}
+
+    static constexpr FixedWide fromRaw(int64_t value) { FixedWide f; f.raw = value; return f; }
+    constexpr int64_t getRaw() const { return raw; }
+
+    constexpr FixedWide operator+(FixedWide o) const { return fromRaw(raw + o.raw); }
+    constexpr FixedWide operator-(FixedWide o) const { return fromRaw(raw - o.raw); }
+    constexpr FixedWide operator-() const { return fromRaw(-raw); }
+
+    constexpr bool operator==(FixedWide o) const { return raw == o.raw; }
+    constexpr bool operator!=(FixedWide o) const { return raw != o.raw; }
+    constexpr bool operator<(FixedWide o) const { return raw < o.raw; }
+    constexpr bool operator<=(FixedWide o) const { return raw <= o.raw; }
+    constexpr bool operator>(FixedWide o) const { return raw > o.raw; }
+    constexpr bool operator>=(FixedWide o) const { return raw >= o.raw; }
+};
+
+ /**
+  * @brief Liczba stałoprzecinkowa Q16.16
+  */
+class Fixed {
+private:
+    int32_t raw;  ///< Wartość * 65536
+
+public:
+    static const int FRACTION_BITS = 16;              ///< Liczba bitów części ułamkowej
+    static const int32_t ONE = 1 << FRACTION_BITS;    ///< Surowa wartość 1.0
+
+    constexpr Fixed() : raw(0) {}
+    constexpr explicit Fixed(int value) : raw(static_cast<int32_t>(value) * ONE) {}
+
+    /**
+     * @brief Tworzy liczbę z surowej reprezentacji
+     */
+    static constexpr Fixed fromRaw(int32_t value) { Fixed f; f.raw = value; return f; }
+
+    /**
+     * @brief Konwersja z float z zaokrągleniem do najbliższej wartości
+     *
+     * Mnożenie przez potęgę dwójki i floor są dokładne, więc wynik nie zależy od platformy.
+     * Wartości spoza zakresu są nasycane (NaN daje 0).
+     */
+    static Fixed fromFloat(float value) {
+        float scaled = std::floor(value * static_cast<float>(ONE) + 0.5f);
+        if (scaled >= 2147483648.0f) return fromRaw(INT32_MAX);
+        if (scaled < -2147483648.0f) return fromRaw(INT32_MIN);
+        if (scaled != scaled) return Fixed();
+        return fromRaw(static_cast<int32_t>(scaled));
+    }
+
+    constexpr int32_t getRaw() const { return raw; }
+    float toFloat() const { return static_cast<float>(raw) / static_cast<float>(ONE); }
+    constexpr int toInt() const { return raw >> FRACTION_BITS; }
+
+    constexpr Fixed operator+(Fixed o) const { return fromRaw(raw + o.raw); }
+    constexpr Fixed operator-(Fixed o) const { return fromRaw(raw - o.raw); }
+    constexpr Fixed operator-() const { return fromRaw(-raw); }
+    constexpr Fixed operator*(Fixed o) const {
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) * o.raw + (ONE >> 1)) >> FRACTION_BITS));
+    }
+    constexpr Fixed operator/(Fixed o) const {
+        return fromRaw(static_cast<int32_t>((static_cast<int64_t>(raw) << FRACTION_BITS) / o.raw));
+    }
+
+    Fixed& operator+=(Fixed o) { raw += o.raw; return *this; }
+    Fixed& operator-=(Fixed o) { raw -= o.raw; return *this; }
+    Fixed& operator*=(Fixed o) { return *this = *this * o; }
+    Fixed& operator/=(Fixed o) { return *this = *this / o; }
+
+    constexpr bool operator==(Fixed o) const { return raw == o.raw; }
+    constexpr bool operator!=(Fixed o) const { return raw != o.raw; }
+    constexpr bool operator<(Fixed o) const { return raw < o.raw; }
+    constexpr bool operator<=(Fixed o) const { return raw <= o.raw; }
+    constexpr bool operator>(Fixed o) const { return raw > o.raw; }
+    constexpr bool operator>=(Fixed o) const { return raw >= o.raw; }
+
+    constexpr Fixed abs() const { return raw < 0 ? fromRaw(-raw) : *this; }
+
+    /**
+     * @brief Dokładny iloczyn w Q32.32 (bez zaokrąglenia i przepełnienia)
+     */
+    static constexpr FixedWide mulWide(Fixed a, Fixed b) {
+        return FixedWide::fromRaw(static_cast<int64_t>(a.raw) * b.raw);
+    }
+
+    /**
+     * @brief Iloraz dwóch wartości Q32.32 jako Q16.16
+     * @return num / den, nasycany do zakresu Q16.16; 0 gdy den == 0
+     */
+    static Fixed ratio(FixedWide num, FixedWide den);
+
+    /**
+     * @brief Pierwiastek kwadratowy (całkowitoliczbowy, zaokrąglony w dół)
+     * @return sqrt(x) lub 0 dla wartości ujemnych
+     */
+    static Fixed sqrt(Fixed x);
+
+    /**
+     * @brief Pierwiastek kwadratowy liczby Q32.32 (np. kwadratu długości liczonego w int64)
+     * @param rawQ32 Wartość * 2^32
+     * @return sqrt w Q16.16, nasycany do największej wartości Q16.16
+     */
+    static Fixed sqrtWide(uint64_t rawQ32);
+
+    /**
+     * @brief Długość wektora (x, y) - kwadraty sumowane w Q32.32, bez przepełnienia
+     */
+    static Fixed length(Fixed x, Fixed y);
+
+    /**
+     * @brief Sinus i cosinus kąta w radianach (CORDIC, błąd rzędu 2^-16)
+     */
+    static void sincos(Fixed angle, Fixed& sinOut, Fixed& cosOut);
+    static Fixed sin(Fixed angle);
+    static Fixed cos(Fixed angle);
+
+    /**
+     * @brief Kąt wektora (y, x) w radianach z zakresu [-PI, PI] (CORDIC)
+     */
+    static Fixed atan2(Fixed y, Fixed x);
+
+    static constexpr Fixed pi() { return fromRaw(205887); }
+    static constexpr Fixed halfPi() { return fromRaw(102944); }
+    static constexpr Fixed twoPi() { return fromRaw(411775); }
+};
+
+#endif // FIXED_H
@@ -0,0 +1,267 @@
+﻿#include "Hud.h"
+#include <allegro5/allegro_primitives.h>
+#include <algorithm>
+#include <cmath>
+
+// HudWidget
+HudWidget::HudWidget(float x, float y)
+    : x(x)
+    , y(y)
+    , visible(true)
+{
+}
+
+bool HudWidget::update() {
+    bool nowVisible = visibilityBinding ? visibilityBinding() : true;
+    bool valueChanged = refreshValue();
+
+    bool changed = (nowVisible != visible) || (nowVisible && valueChanged);
+    visible = nowVisible;
+    return changed;
+}
+
+void HudWidget::setVisibilityBinding(std::function<bool()> binding) {
+    visibilityBinding = binding;
+}
+
+// HudText
+HudText::HudText(float x, float y, ALLEGRO_COLOR color, int align, std::function<std::string()> binding)
+    : HudWidget(x, y)
+    , binding(binding)
+    , color(color)
+    , align(align)
+    , cacheRuns(true)
+{
+}
+
+bool HudText::refreshValue() {
+    if (!binding) return false;
+
+    std::string newText = binding();
+    if (newText == text) {
+        return false;
+    }
+    text.swap(newText);
+    return true;
+}
+
+HudRect HudText::getBounds(TextRunCache& cache) {
+    int textWidth = cache.measure(text);
+    float left = x;
+    if (align & ALLEGRO_ALIGN_CENTER) {
+        left -= textWidth / 2.0f;
+    }
+    else if (align & ALLEGRO_ALIGN_RIGHT) {
+        left -= textWidth;
+    }
+
+    // Margines 1px na zaokrąglenia pozycji
+    return HudRect(static_cast<int>(std::floor(left)) - 1, static_cast<int>(std::floor(y)) - 1,
+        textWidth + 2, cache.getLineHeight() + 2);
+}
+
+void HudText::render(TextRunCache& cache) {
+    if (text.empty()) return;
+
+    if (cacheRuns) {
+        cache.draw(text, color, x, y, align);
+    }
+    else {
+        al_draw_text(cache.getFont(), color, x, y, align, text.c_str());
+    }
+}
+
+// HudBar
+HudBar::HudBar(float x, float y, float width, float height, ALLEGRO_COLOR fillColor, std::function<float()> binding)
+    : HudWidget(x, y)
+    , binding(binding)
+    , width(width)
+    , height(height)
+    , fillColor(fillColor)
+    , backgroundColor(al_map_rgba(0, 0, 0, 0))
+    , hasBackground(false)
+    , filledPixels(-1)
+{
+}
+
+bool HudBar::refreshValue() {
+    if (!binding) return false;
+
+    float fraction = std::max(0.0f, std::min(1.0f, binding()));
+    int pixels = static_cast<int>(fraction * width);
+    if (pixels == filledPixels) {
+        return false;
+    }
+    filledPixels = pixels;
+    return true;
+}
+
+HudRect HudBar::getBounds(TextRunCache& cache) {
+    return HudRect(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)),
+        static_cast<int>(std::ceil(width)) + 1, static_cast<int>(std::ceil(height)) + 1);
+}
+
+void HudBar::render(TextRunCache& cache) {
+    if (hasBackground) {
+        al_draw_filled_rectangle(x, y, x + width, y + height, backgroundColor);
+    }
+    if (filledPixels > 0) {
+        al_draw_filled_rectangle(x, y, x + filledPixels, y + height, fillColor);
+    }
+}
+
+void HudBar::setBackground(ALLEGRO_COLOR color) {
+    backgroundColor = color;
+    hasBackground = true;
+}
+
+// HudLayer
+HudLayer::HudLayer()
+    : cache(nullptr)
+    , width(0)
+    , height(0)
+    , fullRedraw(true)
+    , lastRedrawCount(0)
+{
+}
+
+HudLayer::~HudLayer() {
+    for (auto widget : widgets) {
+        delete widget;
+    }
+    widgets.clear();
+
+    textCache.clear();
+    if (cache) {
+        al_destroy_bitmap(cache);
+        cache = nullptr;
+    }
+}
+
+bool HudLayer::init(int newWidth, int newHeight, ALLEGRO_FONT* font) {
+    if (cache) {
+        al_destroy_bitmap(cache);
+    }
+
+    width = newWidth;
+    height = newHeight;
+    textCache.setFont(font);
+    cache = al_create_bitmap(width, height);
+    fullRedraw = true;
+    return cache != nullptr;
+}
+
+HudText* HudLayer::addText(float x, float y, ALLEGRO_COLOR color, int align, std::function<std::string()> binding) {
+    HudText* text = new HudText(x, y, color, align, binding);
+    widgets.push_back(text);
+    fullRedraw = true;
+    return text;
+}
+
+HudBar* HudLayer::addBar(float x, float y, float barWidth, float barHeight, ALLEGRO_COLOR fillColor, std::function<float()> binding) {
+    HudBar* bar = new HudBar(x, y, barWidth, barHeight, fillColor, binding);
+    widgets.push_back(bar);
+    fullRedraw = true;
+    return bar;
+}
+
+void HudLayer::renderRegion(const HudRect& region) {
+    al_set_clipping_rectangle(region.x, region.y, region.width, region.height);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+
+    // Przerysowanie wszystkich widżetów nachodzących na obszar (z zachowaniem kolejności)
+    for (auto widget : widgets) {
+        if (widget->isVisible() && widget->lastBounds.intersects(region)) {
+            widget->render(textCache);
+        }
+    }
+}
+
+void HudLayer::draw() {
+    textCache.beginFrame();
+    damaged.clear();
+    lastRedrawCount = 0;
+
+    for (auto widget : widgets) {
+        if (!widget->update() && !fullRedraw) {
+            continue;
+        }
+
+        // Stary obszar trzeba wyczyścić, nowy narysować
+        damaged.push_back(widget->lastBounds);
+        widget->lastBounds = widget->isVisible() ? widget->getBounds(textCache) : HudRect();
+        damaged.push_back(widget->lastBounds);
+        lastRedrawCount++;
+    }
+
+    if (!cache) {
+        // Brak bufora - rysujemy widżety bezpośrednio
+        for (auto widget : widgets) {
+            if (widget->isVisible()) {
+                widget->render(textCache);
+            }
+        }
+        return;
+    }
+
+    if (fullRedraw || !damaged.empty()) {
+        ALLEGRO_BITMAP* prevTarget = al_get_target_bitmap();
+        al_set_target_bitmap(cache);
+
+        if (fullRedraw) {
+            renderRegion(HudRect(0, 0, width, height));
+            fullRedraw = false;
+        }
+        else {
+            for (const auto& region : damaged) {
+                if (!region.isEmpty()) {
+                    renderRegion(region);
+                }
+            }
+        }
+
+        al_reset_clipping_rectangle();
+        al_set_target_bitmap(prevTarget);
+    }
+
+    // Kopiowanie tylko obszarów widżetów zamiast całego bufora wielkości ekranu
+    blitRects.clear();
+    for (auto widget : widgets) {
+        if (!widget->isVisible() || widget->lastBounds.isEmpty()) {
+            continue;
+        }
+
+        // Prostokąty nachodzące na siebie łączone są w jeden (przezroczyste piksele
+        // nie mogą być mieszane dwukrotnie)
+        HudRect rect = widget->lastBounds;
+        for (size_t i = 0; i < blitRects.size();) {
+            if (blitRects[i].intersects(rect)) {
+                rect = rect.united(blitRects[i]);
+                blitRects[i] = blitRects.back();
+                blitRects.pop_back();
+                i = 0;
+            }
+            else {
+                i++;
+            }
+        }
+        blitRects.push_back(rect);
+    }
+
+    al_hold_bitmap_drawing(true);
+    for (const auto& rect : blitRects) {
+        // Przycięcie do rozmiaru bufora (marginesy widżetów mogą wychodzić poza ekran)
+        int left = std::max(rect.x, 0);
+        int top = std::max(rect.y, 0);
+        int right = std::min(rect.x + rect.width, width);
+        int bottom = std::min(rect.y + rect.height, height);
+        if (right <= left || bottom <= top) {
+            continue;
+        }
+        al_draw_bitmap_region(cache,
+            static_cast<float>(left), static_cast<float>(top),
+            static_cast<float>(right - left), static_cast<float>(bottom - top),
+            static_cast<float>(left), static_cast<float>(top), 0);
+    }
+    al_hold_bitmap_drawing(false);
+}
@@ -0,0 +1,231 @@
+﻿/**
+ * @file Hud.h
+ * @brief Warstwa interfejsu (HUD) renderowana do buforowanej bitmapy
+ *
+ * HudLayer przechowuje widżety (teksty, paski) powiązane z wartościami gry.
+ * Co klatkę sprawdzane są jedynie powiązane wartości - ponownie
+ * rasteryzowane są tylko widżety, których wartość faktycznie się zmieniła,
+ * a na ekran kopiowane są z bufora tylko obszary widocznych widżetów.
+ */
+
+#ifndef HUD_H
+#define HUD_H
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "TextCache.h"
+
+ /**
+  * @brief Prostokąt w pikselach ekranu używany do śledzenia zmian
+  */
+struct HudRect {
+    int x;       ///< Lewa krawędź
+    int y;       ///< Górna krawędź
+    int width;   ///< Szerokość
+    int height;  ///< Wysokość
+
+    HudRect() : x(0), y(0), width(0), height(0) {}
+    HudRect(int x, int y, int width, int height) : x(x), y(y), width(width), height(height) {}
+
+    bool isEmpty() const { return width <= 0 || height <= 0; }
+
+    bool intersects(const HudRect& other) const {
+        return !isEmpty() && !other.isEmpty() &&
+            x < other.x + other.width && other.x < x + width &&
+            y < other.y + other.height && other.y < y + height;
+    }
+
+    HudRect united(const HudRect& other) const {
+        int left = x < other.x ? x : other.x;
+        int top = y < other.y ? y : other.y;
+        int right = x + width > other.x + other.width ? x + width : other.x + other.width;
+        int bottom = y + height > other.y + other.height ? y + height : other.y + other.height;
+        return HudRect(left, top, right - left, bottom - top);
+    }
+};
+
+/**
+ * @brief Bazowa klasa widżetu HUD
+ *
+ * Widżet pobiera swoją wartość przez powiązanie (funkcję) i zgłasza
+ * konieczność przerysowania tylko wtedy, gdy wartość się zmieniła.
+ */
+class HudWidget {
+protected:
+    float x;                                  ///< Pozycja X punktu zaczepienia
+    float y;                                  ///< Pozycja Y punktu zaczepienia
+    bool visible;                             ///< Czy widżet był widoczny przy ostatnim odświeżeniu
+    HudRect lastBounds;                       ///< Obszar zajęty przy ostatniej rasteryzacji
+    std::function<bool()> visibilityBinding;  ///< Opcjonalne powiązanie widoczności
+
+    /**
+     * @brief Pobiera aktualną wartość z powiązania
+     * @return true jeśli wartość zmieniła się od ostatniego odświeżenia
+     */
+    virtual bool refreshValue() = 0;
+
+    friend class HudLayer;
+
+public:
+    HudWidget(float x, float y);
+    virtual ~HudWidget() = default;
+
+    /**
+     * @brief Odświeża widoczność i powiązaną wartość
+     * @return true jeśli widżet wymaga ponownej rasteryzacji
+     */
+    bool update();
+
+    /**
+     * @brief Wylicza obszar zajmowany przez widżet
+     * @param cache Bufor tekstu (do mierzenia napisów)
+     * @return Prostokąt w pikselach ekranu
+     */
+    virtual HudRect getBounds(TextRunCache& cache) = 0;
+
+    /**
+     * @brief Rysuje widżet na aktualnym celu renderowania
+     * @param cache Bufor tekstu
+     */
+    virtual void render(TextRunCache& cache) = 0;
+
+    /**
+     * @brief Ustawia powiązanie widoczności
+     * @param binding Funkcja zwracająca true gdy widżet ma być widoczny
+     */
+    void setVisibilityBinding(std::function<bool()> binding);
+
+    bool isVisible() const { return visible; }
+};
+
+/**
+ * @brief Widżet tekstowy HUD
+ */
+class HudText : public HudWidget {
+private:
+    std::function<std::string()> binding;  ///< Funkcja formatująca tekst
+    std::string text;                      ///< Ostatnio wyświetlany tekst
+    ALLEGRO_COLOR color;                   ///< Kolor tekstu
+    int align;                             ///< Wyrównanie (flagi ALLEGRO_ALIGN_*)
+    bool cacheRuns;                        ///< Czy używać bufora ciągów tekstu
+
+protected:
+    bool refreshValue() override;
+
+public:
+    HudText(float x, float y, ALLEGRO_COLOR color, int align, std::function<std::string()> binding);
+
+    HudRect getBounds(TextRunCache& cache) override;
+    void render(TextRunCache& cache) override;
+
+    /**
+     * @brief Włącza lub wyłącza buforowanie ciągów tekstu
+     * @param enabled false dla tekstów zmieniających się niemal co klatkę
+     */
+    void setRunCaching(bool enabled) { cacheRuns = enabled; }
+};
+
+/**
+ * @brief Widżet paska postępu HUD (zdrowie, przeładowanie itp.)
+ *
+ * Wartość jest kwantyzowana do pełnych pikseli, więc pasek jest
+ * przerysowywany dopiero wtedy, gdy zmieni się jego widoczna długość.
+ */
+class HudBar : public HudWidget {
+private:
+    std::function<float()> binding;  ///< Funkcja zwracająca wypełnienie (0.0 - 1.0)
+    float width;                     ///< Szerokość paska
+    float height;                    ///< Wysokość paska
+    ALLEGRO_COLOR fillColor;         ///< Kolor wypełnienia
+    ALLEGRO_COLOR backgroundColor;   ///< Kolor tła
+    bool hasBackground;              ///< Czy rysować tło
+    int filledPixels;                ///< Ostatnia wypełniona szerokość w pikselach
+
+protected:
+    bool refreshValue() override;
+
+public:
+    HudBar(float x, float y, float width, float height, ALLEGRO_COLOR fillColor, std::function<float()> binding);
+
+    HudRect getBounds(TextRunCache& cache) override;
+    void render(TextRunCache& cache) override;
+
+    /**
+     * @brief Ustawia kolor tła paska
+     * @param color Kolor tła
+     */
+    void setBackground(ALLEGRO_COLOR color);
+};
+
+/**
+ * @brief Warstwa HUD z buforowaną bitmapą i śledzeniem zmian
+ *
+ * Warstwa posiada widżety dodane przez addText/addBar. Metoda draw()
+ * przerysowuje w bitmapie bufora wyłącznie obszary zmienionych widżetów,
+ * a następnie kopiuje na ekran prostokąty widocznych widżetów (nachodzące
+ * na siebie są łączone, aby nie mieszać tych samych pikseli dwukrotnie).
+ */
+class HudLayer {
+private:
+    ALLEGRO_BITMAP* cache;             ///< Bitmapa z wyrenderowanym HUD
+    int width;                         ///< Szerokość warstwy
+    int height;                        ///< Wysokość warstwy
+    std::vector<HudWidget*> widgets;   ///< Widżety (własność warstwy)
+    std::vector<HudRect> damaged;      ///< Obszary do przerysowania w bieżącej klatce
+    std::vector<HudRect> blitRects;    ///< Obszary kopiowane z bufora na ekran
+    TextRunCache textCache;            ///< Bufor glifów i ciągów tekstu
+    bool fullRedraw;                   ///< Wymuszenie przerysowania całej warstwy
+    int lastRedrawCount;               ///< Liczba widżetów przerysowanych w ostatniej klatce
+
+    void renderRegion(const HudRect& region);
+
+    // Zablokowanie kopiowania
+    HudLayer(const HudLayer&) = delete;
+    HudLayer& operator=(const HudLayer&) = delete;
+
+public:
+    HudLayer();
+    ~HudLayer();
+
+    /**
+     * @brief Tworzy bitmapę bufora
+     * @param width Szerokość warstwy (zwykle szerokość ekranu)
+     * @param height Wysokość warstwy (zwykle wysokość ekranu)
+     * @param font Czcionka dla widżetów tekstowych
+     * @return true jeśli udało się utworzyć bufor
+     */
+    bool init(int width, int height, ALLEGRO_FONT* font);
+
+    /**
+     * @brief Dodaje widżet tekstowy
+     * @return Wskaźnik na widżet (własność pozostaje w warstwie)
+     */
+    HudText* addText(float x, float y, ALLEGRO_COLOR color, int align, std::function<std::string()> binding);
+
+    /**
+     * @brief Dodaje widżet paska
+     * @return Wskaźnik na widżet (własność pozostaje w warstwie)
+     */
+    HudBar* addBar(float x, float y, float width, float height, ALLEGRO_COLOR fillColor, std::function<float()> binding);
+
+    /**
+     * @brief Odświeża zmienione widżety i rysuje warstwę na aktualnym celu
+     */
+    void draw();
+
+    /**
+     * @brief Wymusza przerysowanie całej warstwy w następnej klatce
+     */
+    void invalidate() { fullRedraw = true; }
+
+    /**
+     * @brief Pobiera liczbę widżetów przerysowanych w ostatniej klatce
+     * @return Liczba przerysowanych widżetów
+     */
+    int getLastRedrawCount() const { return lastRedrawCount; }
+};
+
+#endif // HUD_H
@@ -0,0 +1,53 @@
+﻿/**
+ * @file MappedFile.h
+ * @brief Plik zmapowany w pamięci tylko do odczytu
+ *
+ * Zawartość pliku jest dostępna jako wskaźnik bez kopiowania i bez
+ * parsowania - strony są wczytywane przez system przy pierwszym dostępie.
+ * Używany przez skompilowane arkusze sprite'ów (SpriteSheet).
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+ /**
+  * @brief Odwzorowanie pliku w pamięci (Windows: CreateFileMapping, POSIX: mmap)
+  */
+class MappedFile {
+private:
+    const unsigned char* data;  ///< Początek odwzorowania
+    size_t size;                ///< Rozmiar pliku w bajtach
+#ifdef _WIN32
+    void* fileHandle;           ///< Uchwyt pliku
+    void* mappingHandle;        ///< Uchwyt odwzorowania
+#endif
+
+    // Zablokowanie kopiowania (odwzorowanie ma jednego właściciela)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**
+     * @brief Mapuje plik (poprzednie odwzorowanie jest zamykane)
+     * @param path Ścieżka do pliku
+     * @return true jeśli plik istnieje, nie jest pusty i udało się go zmapować
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Zamyka odwzorowanie
+     */
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* getData() const { return data; }
+    size_t getSize() const { return size; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,173 @@
+﻿/**
+ * @file Mat2x3.h
+ * @brief Macierz przekształcenia afinicznego 2D
+ *
+ * Mat2x3 przechowuje część liniową (a, b, c, d) i przesunięcie (tx, ty):
+ *   x' = a * x + c * y + tx
+ *   y' = b * x + d * y + ty
+ * Układ odpowiada ALLEGRO_TRANSFORM (m[0][0], m[0][1], m[1][0], m[1][1],
+ * m[3][0], m[3][1]). Złożenie A * B oznacza: najpierw B, potem A.
+ * Sinus i cosinus kąta są liczone raz przy budowie macierzy, a nie dla
+ * każdego punktu, a cała hierarchia przekształceń może zostać złożona
+ * do jednej macierzy i nałożona jednym przebiegiem wsadowym.
+ */
+
+#ifndef MAT2X3_H
+#define MAT2X3_H
+
+#include <cmath>
+#include <cstddef>
+#include "Vec2.h"
+#include "VecBatch.h"
+
+ /**
+  * @brief Macierz przekształcenia afinicznego 2D
+  */
+struct Mat2x3 {
+    float a, b;    ///< Pierwsza kolumna (obraz wektora osi X)
+    float c, d;    ///< Druga kolumna (obraz wektora osi Y)
+    float tx, ty;  ///< Przesunięcie
+
+    /**
+     * @brief Składowe rozkładu macierzy
+     */
+    struct Decomposition {
+        Vec2 translation;  ///< Przesunięcie
+        float rotation;    ///< Obrót w radianach
+        Vec2 scale;        ///< Skala w osiach (ujemna Y dla odbicia)
+        float shear;       ///< Pochylenie (0 dla przekształceń bez ścinania)
+    };
+
+    constexpr Mat2x3() : a(1.0f), b(0.0f), c(0.0f), d(1.0f), tx(0.0f), ty(0.0f) {}
+    constexpr Mat2x3(float a, float b, float c, float d, float tx, float ty)
+        : a(a), b(b), c(c), d(d), tx(tx), ty(ty) {}
+
+    static constexpr Mat2x3 identity() { return Mat2x3(); }
+    static constexpr Mat2x3 translation(float x, float y) { return Mat2x3(1.0f, 0.0f, 0.0f, 1.0f, x, y); }
+    static constexpr Mat2x3 scaling(float sx, float sy) { return Mat2x3(sx, 0.0f, 0.0f, sy, 0.0f, 0.0f); }
+
+    /**
+     * @brief Obrót o kąt w radianach (wokół początku układu)
+     */
+    static Mat2x3 rotation(float radians) {
+        float s = std::sin(radians);
+        float co = std::cos(radians);
+        return Mat2x3(co, s, -s, co, 0.0f, 0.0f);
+    }
+
+    /**
+     * @brief Obrót o kąt w radianach wokół zadanego punktu
+     */
+    static Mat2x3 rotationAbout(float radians, const Vec2& center) {
+        return translation(center.x, center.y) * rotation(radians) * translation(-center.x, -center.y);
+    }
+
+    /**
+     * @brief Skalowanie względem zadanego punktu
+     */
+    static constexpr Mat2x3 scalingAbout(float sx, float sy, const Vec2& center) {
+        return Mat2x3(sx, 0.0f, 0.0f, sy, center.x - center.x * sx, center.y - center.y * sy);
+    }
+
+    /**
+     * @brief Przekształcenie obiektu: przesunięcie punktu zaczepienia, skala, obrót, pozycja
+     * @param position Pozycja obiektu
+     * @param radians Obrót w radianach
+     * @param scale Skala
+     * @param origin Punkt zaczepienia w układzie lokalnym (np. środek sprite'a)
+     */
+    static Mat2x3 fromTRS(const Vec2& position, float radians, const Vec2& scale, const Vec2& origin = Vec2()) {
+        float s = std::sin(radians);
+        float co = std::cos(radians);
+        Mat2x3 m(co * scale.x, s * scale.x, -s * scale.y, co * scale.y, position.x, position.y);
+        m.tx -= m.a * origin.x + m.c * origin.y;
+        m.ty -= m.b * origin.x + m.d * origin.y;
+        return m;
+    }
+
+    /**
+     * @brief Złożenie przekształceń (najpierw o, potem this)
+     */
+    constexpr Mat2x3 operator*(const Mat2x3& o) const {
+        return Mat2x3(
+            a * o.a + c * o.b,
+            b * o.a + d * o.b,
+            a * o.c + c * o.d,
+            b * o.c + d * o.d,
+            a * o.tx + c * o.ty + tx,
+            b * o.tx + d * o.ty + ty);
+    }
+
+    /**
+     * @brief Przekształca punkt
+     */
+    constexpr Vec2 apply(const Vec2& p) const { return Vec2(a * p.x + c * p.y + tx, b * p.x + d * p.y + ty); }
+
+    /**
+     * @brief Przekształca wektor kierunku (bez przesunięcia)
+     */
+    constexpr Vec2 applyVector(const Vec2& v) const { return Vec2(a * v.x + c * v.y, b * v.x + d * v.y); }
+
+    constexpr float determinant() const { return a * d - b * c; }
+
+    /**
+     * @brief Wylicza macierz odwrotną
+     * @param out Macierz wynikowa
+     * @return false gdy macierz jest osobliwa (out pozostaje bez zmian)
+     */
+    bool inverse(Mat2x3& out) const {
+        float det = determinant();
+        if (std::fabs(det) < 1e-12f) {
+            return false;
+        }
+        float inv = 1.0f / det;
+        float ia = d * inv;
+        float ib = -b * inv;
+        float ic = -c * inv;
+        float id = a * inv;
+        out = Mat2x3(ia, ib, ic, id, -(ia * tx + ic * ty), -(ib * tx + id * ty));
+        return true;
+    }
+
+    /**
+     * @brief Zwraca macierz odwrotną lub jednostkową dla macierzy osobliwej
+     */
+    Mat2x3 inverted() const {
+        Mat2x3 result;
+        inverse(result);
+        return result;
+    }
+
+    /**
+     * @brief Rozkłada macierz na przesunięcie, obrót, skalę i pochylenie
+     *
+     * Część liniowa = R(rotation) * [[scale.x, shear], [0, scale.y]].
+     */
+    Decomposition decompose() const {
+        Decomposition result;
+        result.translation = Vec2(tx, ty);
+        float sx = std::sqrt(a * a + b * b);
+        result.rotation = std::atan2(b, a);
+        result.scale = Vec2(sx, sx > 0.0f ? determinant() / sx : 0.0f);
+        result.shear = sx > 0.0f ? (a * c + b * d) / sx : 0.0f;
+        return result;
+    }
+
+    /**
+     * @brief Przekształca tablicę punktów w miejscu
+     */
+    void applyInPlace(Vec2* points, size_t count) const {
+        for (size_t i = 0; i < count; i++) {
+            points[i] = apply(points[i]);
+        }
+    }
+
+    /**
+     * @brief Przekształca punkty w układzie SoA jednym przebiegiem wektorowym
+     */
+    void applyBatch(const float* xs, const float* ys, float* outX, float* outY, size_t count) const {
+        VecBatch::transform(xs, ys, outX, outY, count, a, b, c, d, tx, ty);
+    }
+};
+
+#endif // MAT2X3_H
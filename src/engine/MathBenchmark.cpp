@@ -0,0 +1,166 @@
+﻿#include "MathBenchmark.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+
+namespace {
+    // Wynik sumowany do zmiennej volatile, aby kompilator nie usunął mierzonych pętli
+    volatile float benchmarkSink = 0.0f;
+
+    template <typename Body>
+    double nanosecondsPerElement(Body body, size_t count, int iterations) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            body();
+        }
+        auto end = std::chrono::steady_clock::now();
+        double total = std::chrono::duration<double, std::nano>(end - start).count();
+        return total / (static_cast<double>(count) * iterations);
+    }
+
+    const char* precisionName(FastMath::Precision precision) {
+        return precision == FastMath::Precision::HIGH ? "high" : "low";
+    }
+}
+
+MathBenchmark::MathBenchmark(size_t sampleCount, int iterations, float angleRange)
+    : sampleCount(sampleCount)
+    , iterations(iterations)
+    , angleRange(angleRange)
+{
+}
+
+void MathBenchmark::generateSamples() {
+    angles.resize(sampleCount);
+    xs.resize(sampleCount);
+    ys.resize(sampleCount);
+
+    // Stałe ziarno - te same dane przy każdym uruchomieniu
+    uint32_t state = 12345u;
+    auto next = [&state, this]() {
+        state = state * 1664525u + 1013904223u;
+        return (static_cast<float>(state >> 8) / 16777216.0f * 2.0f - 1.0f) * angleRange;
+    };
+    for (size_t i = 0; i < sampleCount; i++) {
+        angles[i] = next();
+        xs[i] = next();
+        ys[i] = next();
+    }
+}
+
+MathBenchmarkResult MathBenchmark::measureSinCos(FastMath::Precision precision) {
+    MathBenchmarkResult result;
+    result.name = std::string("sincos (") + precisionName(precision) + ")";
+    std::vector<float> sinOut(sampleCount), cosOut(sampleCount);
+
+    result.libmNs = nanosecondsPerElement([&]() {
+        float sum = 0.0f;
+        for (size_t i = 0; i < sampleCount; i++) {
+            sum += std::sin(angles[i]) + std::cos(angles[i]);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }, sampleCount, iterations);
+
+    result.scalarNs = nanosecondsPerElement([&]() {
+        float sum = 0.0f;
+        for (size_t i = 0; i < sampleCount; i++) {
+            float s, c;
+            FastMath::sincos(angles[i], s, c, precision);
+            sum += s + c;
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }, sampleCount, iterations);
+
+    result.batchNs = nanosecondsPerElement([&]() {
+        FastMath::sincos(angles.data(), sinOut.data(), cosOut.data(), sampleCount, precision);
+        benchmarkSink = benchmarkSink + sinOut[sampleCount / 2];
+    }, sampleCount, iterations);
+
+    // Błąd liczony dla obu wersji względem wyniku w double
+    double maxError = 0.0;
+    for (size_t i = 0; i < sampleCount; i++) {
+        double reference = angles[i];
+        float s, c;
+        FastMath::sincos(angles[i], s, c, precision);
+        maxError = std::fmax(maxError, std::fabs(s - std::sin(reference)));
+        maxError = std::fmax(maxError, std::fabs(c - std::cos(reference)));
+        maxError = std::fmax(maxError, std::fabs(sinOut[i] - std::sin(reference)));
+        maxError = std::fmax(maxError, std::fabs(cosOut[i] - std::cos(reference)));
+    }
+    result.maxError = maxError;
+    result.errorBound = FastMath::maxError(FastMath::Function::SINCOS, precision);
+    result.withinBound = maxError <= result.errorBound;
+    return result;
+}
+
+MathBenchmarkResult MathBenchmark::measureAtan2(FastMath::Precision precision) {
+    MathBenchmarkResult result;
+    result.name = std::string("atan2 (") + precisionName(precision) + ")";
+    std::vector<float> out(sampleCount);
+
+    result.libmNs = nanosecondsPerElement([&]() {
+        float sum = 0.0f;
+        for (size_t i = 0; i < sampleCount; i++) {
+            sum += std::atan2(ys[i], xs[i]);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }, sampleCount, iterations);
+
+    result.scalarNs = nanosecondsPerElement([&]() {
+        float sum = 0.0f;
+        for (size_t i = 0; i < sampleCount; i++) {
+            sum += FastMath::atan2(ys[i], xs[i], precision);
+        }
+        benchmarkSink = benchmarkSink + sum;
+    }, sampleCount, iterations);
+
+    result.batchNs = nanosecondsPerElement([&]() {
+        FastMath::atan2(ys.data(), xs.data(), out.data(), sampleCount, precision);
+        benchmarkSink = benchmarkSink + out[sampleCount / 2];
+    }, sampleCount, iterations);
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < sampleCount; i++) {
+        double reference = std::atan2(static_cast<double>(ys[i]), static_cast<double>(xs[i]));
+        maxError = std::fmax(maxError, std::fabs(FastMath::atan2(ys[i], xs[i], precision) - reference));
+        maxError = std::fmax(maxError, std::fabs(out[i] - reference));
+    }
+    result.maxError = maxError;
+    result.errorBound = FastMath::maxError(FastMath::Function::ATAN2, precision);
+    result.withinBound = maxError <= result.errorBound;
+    return result;
+}
+
+bool MathBenchmark::run() {
+    generateSamples();
+    results.clear();
+    results.push_back(measureSinCos(FastMath::Precision::HIGH));
+    results.push_back(measureSinCos(FastMath::Precision::LOW));
+    results.push_back(measureAtan2(FastMath::Precision::HIGH));
+    results.push_back(measureAtan2(FastMath::Precision::LOW));
+
+    bool passed = true;
+    for (const MathBenchmarkResult& result : results) {
+        passed = passed && result.withinBound;
+    }
+    return passed;
+}
+
+void MathBenchmark::printReport(std::ostream& out) const {
+    out << std::left << std::setw(16) << "function"
+        << std::right << std::setw(10) << "libm ns" << std::setw(10) << "fast ns" << std::setw(10) << "batch ns"
+        << std::setw(9) << "speedup" << std::setw(12) << "max error" << std::setw(12) << "bound" << "\n";
+
+    for (const MathBenchmarkResult& result : results) {
+        double best = std::fmin(result.scalarNs, result.batchNs);
+        out << std::left << std::setw(16) << result.name << std::right
+            << std::fixed << std::setprecision(2)
+            << std::setw(10) << result.libmNs << std::setw(10) << result.scalarNs << std::setw(10) << result.batchNs
+            << std::setw(8) << (best > 0.0 ? result.libmNs / best : 0.0) << "x"
+            << std::scientific << std::setprecision(2)
+            << std::setw(12) << result.maxError << std::setw(12) << result.errorBound
+            << (result.withinBound ? "" : "  EXCEEDED") << "\n";
+    }
+    out << std::defaultfloat;
+}
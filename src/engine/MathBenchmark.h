@@ -0,0 +1,73 @@
+﻿/**
+ * @file MathBenchmark.h
+ * @brief Mikrobenchmark szybkiej trygonometrii (FastMath) względem <cmath>
+ *
+ * Dla każdej funkcji i poziomu dokładności mierzy czas na element wersji
+ * skalarnej i wsadowej FastMath oraz odpowiadających funkcji biblioteki
+ * standardowej, a także maksymalny błąd względem wyniku w double.
+ * Uruchamiany parametrem --math-bench.
+ */
+
+#ifndef MATH_BENCHMARK_H
+#define MATH_BENCHMARK_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "FastMath.h"
+
+ /**
+  * @brief Wynik pomiaru jednej funkcji
+  */
+struct MathBenchmarkResult {
+    std::string name;       ///< Nazwa przypadku
+    double libmNs;          ///< Czas <cmath> na element (ns)
+    double scalarNs;        ///< Czas wersji skalarnej FastMath na element (ns)
+    double batchNs;         ///< Czas wersji wsadowej FastMath na element (ns)
+    double maxError;        ///< Największy zmierzony błąd bezwzględny
+    float errorBound;       ///< Deklarowany błąd (FastMath::maxError)
+    bool withinBound;       ///< Czy błąd mieści się w deklarowanym
+};
+
+/**
+ * @brief Mikrobenchmark FastMath
+ */
+class MathBenchmark {
+private:
+    size_t sampleCount;                        ///< Liczba próbek
+    int iterations;                            ///< Liczba powtórzeń pomiaru
+    float angleRange;                          ///< Zakres kątów i składowych [-range, range]
+    std::vector<float> angles;                 ///< Kąty wejściowe
+    std::vector<float> xs;                     ///< Składowe X dla atan2
+    std::vector<float> ys;                     ///< Składowe Y dla atan2
+    std::vector<MathBenchmarkResult> results;  ///< Wyniki ostatniego uruchomienia
+
+    void generateSamples();
+    MathBenchmarkResult measureSinCos(FastMath::Precision precision);
+    MathBenchmarkResult measureAtan2(FastMath::Precision precision);
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param sampleCount Liczba próbek wejściowych
+     * @param iterations Liczba powtórzeń każdego pomiaru
+     * @param angleRange Zakres losowanych kątów (radiany)
+     */
+    MathBenchmark(size_t sampleCount = 1 << 16, int iterations = 20, float angleRange = 1000.0f);
+
+    /**
+     * @brief Wykonuje wszystkie pomiary
+     * @return true jeśli wszystkie błędy mieszczą się w deklarowanych granicach
+     */
+    bool run();
+
+    const std::vector<MathBenchmarkResult>& getResults() const { return results; }
+
+    /**
+     * @brief Wypisuje tabelę wyników
+     * @param out Strumień wyjściowy
+     */
+    void printReport(std::ostream& out) const;
+};
+
+#endif // MATH_BENCHMARK_H
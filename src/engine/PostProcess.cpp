@@ -0,0 +1,384 @@
+﻿#include "PostProcess.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define POST_PROCESS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    inline int clampIndex(int value, int maxValue) {
+        return value < 0 ? 0 : (value > maxValue ? maxValue : value);
+    }
+
+#ifdef POST_PROCESS_SSE2
+    // Piksel RGBA8 -> 4 x int32
+    inline __m128i loadPixel32(const uint8_t* pixel) {
+        int32_t value;
+        std::memcpy(&value, pixel, sizeof(value));
+        const __m128i zero = _mm_setzero_si128();
+        __m128i wide = _mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero);
+        return _mm_unpacklo_epi16(wide, zero);
+    }
+
+    // 4 x int32 (suma okna) * 1/n -> piksel RGBA8
+    // Zaokrąglenie jak w wersji skalarnej: + 0.5 i obcięcie (nie do parzystej)
+    inline void storeAverage(uint8_t* pixel, __m128i sum, __m128 inverse) {
+        __m128 scaled = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sum), inverse), _mm_set1_ps(0.5f));
+        __m128i value = _mm_cvttps_epi32(scaled);
+        value = _mm_packs_epi32(value, value);
+        value = _mm_packus_epi16(value, value);
+        int32_t packed = _mm_cvtsi128_si32(value);
+        std::memcpy(pixel, &packed, sizeof(packed));
+    }
+#endif
+
+    // Rozmycie pudełkowe jednego wiersza (suma przesuwna, krawędzie powielane)
+    void boxBlurRow(const uint8_t* src, uint8_t* dst, int width, int radius) {
+        const int last = width - 1;
+        const float inverse = 1.0f / (2 * radius + 1);
+
+#ifdef POST_PROCESS_SSE2
+        const __m128 inverseVec = _mm_set1_ps(inverse);
+        __m128i sum = _mm_setzero_si128();
+        for (int k = -radius; k <= radius; k++) {
+            sum = _mm_add_epi32(sum, loadPixel32(src + clampIndex(k, last) * 4));
+        }
+        for (int x = 0; x < width; x++) {
+            storeAverage(dst + x * 4, sum, inverseVec);
+            sum = _mm_add_epi32(sum, loadPixel32(src + clampIndex(x + radius + 1, last) * 4));
+            sum = _mm_sub_epi32(sum, loadPixel32(src + clampIndex(x - radius, last) * 4));
+        }
+#else
+        int sum[4] = { 0, 0, 0, 0 };
+        for (int k = -radius; k <= radius; k++) {
+            const uint8_t* p = src + clampIndex(k, last) * 4;
+            for (int c = 0; c < 4; c++) sum[c] += p[c];
+        }
+        for (int x = 0; x < width; x++) {
+            const uint8_t* in = src + clampIndex(x + radius + 1, last) * 4;
+            const uint8_t* out = src + clampIndex(x - radius, last) * 4;
+            for (int c = 0; c < 4; c++) {
+                dst[x * 4 + c] = static_cast<uint8_t>(sum[c] * inverse + 0.5f);
+                sum[c] += in[c] - out[c];
+            }
+        }
+#endif
+    }
+
+    // Rozmycie pionowe - sumy kolumn przesuwane całymi wierszami
+    void boxBlurColumns(const SoftwareRenderTarget& src, SoftwareRenderTarget& dst, int radius, std::vector<int32_t>& sums) {
+        const int width = src.getWidth();
+        const int last = src.getHeight() - 1;
+        const float inverse = 1.0f / (2 * radius + 1);
+
+        sums.assign(static_cast<size_t>(width) * 4, 0);
+        for (int k = -radius; k <= radius; k++) {
+            const uint8_t* row = src.getRow(clampIndex(k, last));
+            for (int i = 0; i < width * 4; i++) sums[i] += row[i];
+        }
+
+#ifdef POST_PROCESS_SSE2
+        const __m128 inverseVec = _mm_set1_ps(inverse);
+#endif
+        for (int y = 0; y <= last; y++) {
+            uint8_t* out = dst.getRow(y);
+            const uint8_t* incoming = src.getRow(clampIndex(y + radius + 1, last));
+            const uint8_t* outgoing = src.getRow(clampIndex(y - radius, last));
+
+            for (int x = 0; x < width; x++) {
+                int32_t* sum = sums.data() + x * 4;
+#ifdef POST_PROCESS_SSE2
+                __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum));
+                storeAverage(out + x * 4, s, inverseVec);
+                s = _mm_add_epi32(s, loadPixel32(incoming + x * 4));
+                s = _mm_sub_epi32(s, loadPixel32(outgoing + x * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sum), s);
+#else
+                for (int c = 0; c < 4; c++) {
+                    out[x * 4 + c] = static_cast<uint8_t>(sum[c] * inverse + 0.5f);
+                    sum[c] += incoming[x * 4 + c] - outgoing[x * 4 + c];
+                }
+#endif
+            }
+        }
+    }
+}
+
+// BlurEffect
+BlurEffect::BlurEffect(int radius, bool gaussian)
+    : radius(radius)
+    , passes(gaussian ? 3 : 1)
+{
+}
+
+void BlurEffect::apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    if (width == 0 || height == 0) return;
+
+    SoftwareRenderTarget* scratch = pool.acquireSoftware(width, height);
+    std::vector<int32_t> sums;
+
+    for (int pass = 0; pass < passes; pass++) {
+        for (int y = 0; y < height; y++) {
+            boxBlurRow(frame.getRow(y), scratch->getRow(y), width, radius);
+        }
+        boxBlurColumns(*scratch, frame, radius, sums);
+    }
+
+    pool.releaseSoftware(scratch);
+}
+
+// VignetteEffect
+VignetteEffect::VignetteEffect(float strength, float radius)
+    : strength(strength)
+    , radius(radius)
+    , cachedWidth(0)
+    , cachedHeight(0)
+    , dirty(true)
+{
+}
+
+void VignetteEffect::rebuildWeights(int width, int height) {
+    weights.resize(static_cast<size_t>(width) * height);
+
+    float centerX = width / 2.0f;
+    float centerY = height / 2.0f;
+    float halfDiagonal = std::sqrt(centerX * centerX + centerY * centerY);
+    float inner = std::min(radius, 0.999f);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float dx = x + 0.5f - centerX;
+            float dy = y + 0.5f - centerY;
+            float distance = std::sqrt(dx * dx + dy * dy) / halfDiagonal;
+
+            // Płynne przejście (smoothstep) od promienia do krawędzi
+            float t = std::min(1.0f, std::max(0.0f, (distance - inner) / (1.0f - inner)));
+            t = t * t * (3.0f - 2.0f * t);
+            float weight = 1.0f - strength * t;
+            weights[static_cast<size_t>(y) * width + x] = static_cast<uint16_t>(weight * 256.0f + 0.5f);
+        }
+    }
+
+    cachedWidth = width;
+    cachedHeight = height;
+    dirty = false;
+}
+
+void VignetteEffect::apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    if (dirty || width != cachedWidth || height != cachedHeight) {
+        rebuildWeights(width, height);
+    }
+
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = frame.getRow(y);
+        const uint16_t* w = weights.data() + static_cast<size_t>(y) * width;
+        int x = 0;
+
+#ifdef POST_PROCESS_SSE2
+        // Dwa piksele na iterację: 8 kanałów 16-bitowych * waga >> 8 (alfa bez zmian)
+        const __m128i zero = _mm_setzero_si128();
+        for (; x + 1 < width; x += 2) {
+            __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x * 4)), zero);
+            __m128i factors = _mm_set_epi16(256, w[x + 1], w[x + 1], w[x + 1], 256, w[x], w[x], w[x]);
+            pixels = _mm_srli_epi16(_mm_mullo_epi16(pixels, factors), 8);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(row + x * 4), _mm_packus_epi16(pixels, pixels));
+        }
+#endif
+        for (; x < width; x++) {
+            uint8_t* p = row + x * 4;
+            p[0] = static_cast<uint8_t>((p[0] * w[x]) >> 8);
+            p[1] = static_cast<uint8_t>((p[1] * w[x]) >> 8);
+            p[2] = static_cast<uint8_t>((p[2] * w[x]) >> 8);
+        }
+    }
+}
+
+// ColorGradeEffect
+ColorGradeEffect::ColorGradeEffect() {
+    for (int c = 0; c < 3; c++) {
+        for (int i = 0; i < 256; i++) {
+            lut[c][i] = static_cast<uint8_t>(i);
+        }
+    }
+}
+
+void ColorGradeEffect::setParameters(float brightness, float contrast, ALLEGRO_COLOR tint) {
+    const float tints[3] = { tint.r, tint.g, tint.b };
+    for (int c = 0; c < 3; c++) {
+        for (int i = 0; i < 256; i++) {
+            float value = i / 255.0f;
+            value = (value - 0.5f) * contrast + 0.5f + brightness;
+            value *= tints[c];
+            value = std::min(1.0f, std::max(0.0f, value));
+            lut[c][i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+    }
+}
+
+void ColorGradeEffect::setTable(int channel, const uint8_t table[256]) {
+    if (channel < 0 || channel > 2) return;
+    std::memcpy(lut[channel], table, 256);
+}
+
+void ColorGradeEffect::apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) {
+    const int width = frame.getWidth();
+    for (int y = 0; y < frame.getHeight(); y++) {
+        uint8_t* p = frame.getRow(y);
+        for (int x = 0; x < width; x++, p += 4) {
+            p[0] = lut[0][p[0]];
+            p[1] = lut[1][p[1]];
+            p[2] = lut[2][p[2]];
+        }
+    }
+}
+
+// HitFlashEffect
+HitFlashEffect::HitFlashEffect(ALLEGRO_COLOR color, float duration)
+    : color(color)
+    , intensity(0.0f)
+    , duration(duration)
+{
+}
+
+void HitFlashEffect::trigger(float strength) {
+    intensity = std::max(intensity, std::min(1.0f, strength));
+}
+
+void HitFlashEffect::update(float deltaTime) {
+    if (intensity > 0.0f) {
+        intensity = std::max(0.0f, intensity - deltaTime / duration);
+    }
+}
+
+void HitFlashEffect::apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) {
+    const uint16_t t = static_cast<uint16_t>(intensity * 256.0f + 0.5f);
+    const uint16_t keep = static_cast<uint16_t>(256 - t);
+    const uint16_t add[3] = {
+        static_cast<uint16_t>(std::min(1.0f, std::max(0.0f, color.r)) * 255.0f * t + 0.5f),
+        static_cast<uint16_t>(std::min(1.0f, std::max(0.0f, color.g)) * 255.0f * t + 0.5f),
+        static_cast<uint16_t>(std::min(1.0f, std::max(0.0f, color.b)) * 255.0f * t + 0.5f)
+    };
+    const int width = frame.getWidth();
+
+#ifdef POST_PROCESS_SSE2
+    // Alfa: mnożnik 256 i brak składnika koloru - kanał pozostaje bez zmian
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i keepVec = _mm_set_epi16(256, keep, keep, keep, 256, keep, keep, keep);
+    const __m128i addVec = _mm_set_epi16(0, add[2], add[1], add[0], 0, add[2], add[1], add[0]);
+#endif
+
+    for (int y = 0; y < frame.getHeight(); y++) {
+        uint8_t* row = frame.getRow(y);
+        int x = 0;
+#ifdef POST_PROCESS_SSE2
+        for (; x + 1 < width; x += 2) {
+            __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x * 4)), zero);
+            pixels = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(pixels, keepVec), addVec), 8);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(row + x * 4), _mm_packus_epi16(pixels, pixels));
+        }
+#endif
+        for (; x < width; x++) {
+            uint8_t* p = row + x * 4;
+            for (int c = 0; c < 3; c++) {
+                p[c] = static_cast<uint8_t>((p[c] * keep + add[c]) >> 8);
+            }
+        }
+    }
+}
+
+// PostProcessor
+PostProcessor::PostProcessor(RenderTargetPool& pool, EngineStats& stats)
+    : pool(pool)
+    , stats(stats)
+    , worldTarget(nullptr)
+    , previousTarget(nullptr)
+{
+}
+
+PostProcessor::~PostProcessor() {
+    for (PostEffect* effect : effects) {
+        delete effect;
+    }
+    effects.clear();
+}
+
+PostEffect* PostProcessor::addEffect(PostEffect* effect) {
+    if (effect) {
+        effects.push_back(effect);
+    }
+    return effect;
+}
+
+void PostProcessor::update(float deltaTime) {
+    for (PostEffect* effect : effects) {
+        effect->update(deltaTime);
+    }
+}
+
+bool PostProcessor::hasActiveEffects() const {
+    for (const PostEffect* effect : effects) {
+        if (effect->isActive()) return true;
+    }
+    return false;
+}
+
+bool PostProcessor::beginWorld(int width, int height) {
+    worldTarget = nullptr;
+    if (!hasActiveEffects()) {
+        return false;
+    }
+
+    worldTarget = pool.acquireBitmap(width, height);
+    if (!worldTarget) {
+        return false;
+    }
+
+    previousTarget = al_get_target_bitmap();
+    al_set_target_bitmap(worldTarget);
+    al_clear_to_color(al_map_rgb(0, 0, 0));
+    return true;
+}
+
+void PostProcessor::endWorld() {
+    if (!worldTarget) {
+        return;
+    }
+
+    al_set_target_bitmap(previousTarget);
+
+    const int width = al_get_bitmap_width(worldTarget);
+    const int height = al_get_bitmap_height(worldTarget);
+    SoftwareRenderTarget* frame = pool.acquireSoftware(width, height);
+
+    bool copied;
+    {
+        EngineStats::ScopedTimer timer(stats, "post.readback");
+        copied = frame->copyFromBitmap(worldTarget);
+    }
+
+    if (copied) {
+        for (PostEffect* effect : effects) {
+            if (effect->isActive()) {
+                EngineStats::ScopedTimer timer(stats, effect->getName());
+                effect->apply(*frame, pool);
+            }
+        }
+
+        EngineStats::ScopedTimer timer(stats, "post.upload");
+        frame->copyToBitmap(worldTarget);
+    }
+
+    al_draw_bitmap(worldTarget, 0, 0, 0);
+
+    pool.releaseSoftware(frame);
+    pool.releaseBitmap(worldTarget);
+    worldTarget = nullptr;
+    previousTarget = nullptr;
+}
@@ -0,0 +1,234 @@
+﻿/**
+ * @file PostProcess.h
+ * @brief Post-processing sceny świata na procesorze
+ *
+ * PostProcessor przechwytuje renderowanie świata do bitmapy pozaekranowej,
+ * kopiuje ją do bufora SoftwareRenderTarget i uruchamia łańcuch efektów
+ * (rozmycie, winieta, korekcja kolorów przez LUT, błysk trafienia).
+ * Jądra efektów przetwarzają całe wiersze RGBA8 i korzystają z SSE2,
+ * gdy jest dostępne. Cele pośrednie pochodzą z RenderTargetPool, a czas
+ * każdego przebiegu trafia do EngineStats (sekcje "post.*").
+ */
+
+#ifndef POST_PROCESS_H
+#define POST_PROCESS_H
+
+#include <allegro5/allegro.h>
+#include <cstdint>
+#include <vector>
+#include "EngineStats.h"
+#include "RenderTarget.h"
+#include "RenderTargetPool.h"
+
+ /**
+  * @brief Bazowa klasa efektu post-processingu
+  */
+class PostEffect {
+protected:
+    bool enabled;   ///< Czy efekt jest włączony
+
+public:
+    PostEffect() : enabled(true) {}
+    virtual ~PostEffect() = default;
+
+    /**
+     * @brief Pobiera nazwę efektu (używaną w statystykach)
+     * @return Nazwa sekcji czasowej, np. "post.blur"
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * @brief Sprawdza czy efekt zmienia obraz w tej klatce
+     * @return true jeśli efekt trzeba zastosować
+     */
+    virtual bool isActive() const { return enabled; }
+
+    /**
+     * @brief Aktualizuje stan efektu zależny od czasu
+     * @param deltaTime Czas klatki w sekundach
+     */
+    virtual void update(float deltaTime) {}
+
+    /**
+     * @brief Stosuje efekt do bufora
+     * @param frame Bufor z obrazem sceny (modyfikowany w miejscu)
+     * @param pool Pula celów pośrednich
+     */
+    virtual void apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) = 0;
+
+    void setEnabled(bool value) { enabled = value; }
+    bool isEnabled() const { return enabled; }
+};
+
+/**
+ * @brief Separowalne rozmycie pudełkowe lub przybliżone gaussowskie
+ *
+ * Rozmycie gaussowskie jest przybliżane trzema kolejnymi przebiegami
+ * rozmycia pudełkowego. Każdy przebieg korzysta z sum przesuwnych,
+ * więc koszt nie zależy od promienia.
+ */
+class BlurEffect : public PostEffect {
+private:
+    int radius;   ///< Promień rozmycia w pikselach
+    int passes;   ///< Liczba przebiegów (1 = pudełkowe, 3 = gaussowskie)
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param radius Promień rozmycia
+     * @param gaussian true dla przybliżenia gaussowskiego
+     */
+    BlurEffect(int radius, bool gaussian = false);
+
+    const char* getName() const override { return "post.blur"; }
+    bool isActive() const override { return enabled && radius > 0; }
+    void apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) override;
+
+    void setRadius(int newRadius) { radius = newRadius; }
+};
+
+/**
+ * @brief Przyciemnienie krawędzi obrazu (winieta)
+ *
+ * Wagi pikseli są liczone raz dla danego rozmiaru i parametrów,
+ * a w kolejnych klatkach jedynie mnożone przez obraz.
+ */
+class VignetteEffect : public PostEffect {
+private:
+    float strength;                ///< Siła przyciemnienia (0-1)
+    float radius;                  ///< Promień jasnego obszaru (względem połowy przekątnej)
+    std::vector<uint16_t> weights; ///< Wagi pikseli (0-256)
+    int cachedWidth;               ///< Rozmiar, dla którego policzono wagi
+    int cachedHeight;
+    bool dirty;                    ///< Czy parametry zmieniły się od policzenia wag
+
+    void rebuildWeights(int width, int height);
+
+public:
+    VignetteEffect(float strength = 0.5f, float radius = 0.75f);
+
+    const char* getName() const override { return "post.vignette"; }
+    bool isActive() const override { return enabled && strength > 0.0f; }
+    void apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) override;
+
+    void setStrength(float value) { strength = value; dirty = true; }
+    void setRadius(float value) { radius = value; dirty = true; }
+};
+
+/**
+ * @brief Korekcja kolorów przez tablice LUT kanałów
+ */
+class ColorGradeEffect : public PostEffect {
+private:
+    uint8_t lut[3][256];   ///< Tablice przejścia dla R, G, B
+
+public:
+    /**
+     * @brief Konstruktor - tablice tożsamościowe
+     */
+    ColorGradeEffect();
+
+    const char* getName() const override { return "post.grade"; }
+    void apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) override;
+
+    /**
+     * @brief Buduje tablice z podstawowych parametrów
+     * @param brightness Przesunięcie jasności (-1 do 1)
+     * @param contrast Mnożnik kontrastu wokół środka (1 = bez zmian)
+     * @param tint Mnożnik koloru dla kanałów R, G, B
+     */
+    void setParameters(float brightness, float contrast, ALLEGRO_COLOR tint);
+
+    /**
+     * @brief Ustawia tablicę jednego kanału
+     * @param channel Kanał (0 = R, 1 = G, 2 = B)
+     * @param table 256 wartości wyjściowych
+     */
+    void setTable(int channel, const uint8_t table[256]);
+};
+
+/**
+ * @brief Krótki błysk koloru po trafieniu
+ *
+ * trigger() ustawia intensywność, która wygasa liniowo w update().
+ * Nieaktywny błysk nie kosztuje nic - PostProcessor go pomija.
+ */
+class HitFlashEffect : public PostEffect {
+private:
+    ALLEGRO_COLOR color;   ///< Kolor błysku
+    float intensity;       ///< Aktualna intensywność (0-1)
+    float duration;        ///< Czas wygasania pełnego błysku w sekundach
+
+public:
+    HitFlashEffect(ALLEGRO_COLOR color, float duration = 0.25f);
+
+    const char* getName() const override { return "post.flash"; }
+    bool isActive() const override { return enabled && intensity > 0.0f; }
+    void update(float deltaTime) override;
+    void apply(SoftwareRenderTarget& frame, RenderTargetPool& pool) override;
+
+    /**
+     * @brief Uruchamia błysk
+     * @param strength Początkowa intensywność (0-1)
+     */
+    void trigger(float strength = 0.6f);
+};
+
+/**
+ * @brief Łańcuch efektów stosowany do sceny świata
+ *
+ * Użycie w pętli renderowania:
+ *   post->beginWorld(w, h); ... rysowanie świata ... post->endWorld();
+ * Gdy żaden efekt nie jest aktywny, świat jest rysowany bezpośrednio
+ * do aktualnego celu, bez kopiowania.
+ */
+class PostProcessor {
+private:
+    RenderTargetPool& pool;             ///< Pula celów pośrednich
+    EngineStats& stats;                 ///< Statystyki silnika (czasy przebiegów)
+    std::vector<PostEffect*> effects;   ///< Efekty w kolejności stosowania (własność)
+    ALLEGRO_BITMAP* worldTarget;        ///< Bitmapa sceny w bieżącej klatce
+    ALLEGRO_BITMAP* previousTarget;     ///< Cel przywracany w endWorld()
+
+    // Zablokowanie kopiowania
+    PostProcessor(const PostProcessor&) = delete;
+    PostProcessor& operator=(const PostProcessor&) = delete;
+
+public:
+    PostProcessor(RenderTargetPool& pool, EngineStats& stats);
+    ~PostProcessor();
+
+    /**
+     * @brief Dodaje efekt na koniec łańcucha (przejmuje własność)
+     * @param effect Efekt
+     * @return Przekazany efekt
+     */
+    PostEffect* addEffect(PostEffect* effect);
+
+    /**
+     * @brief Aktualizuje efekty zależne od czasu
+     * @param deltaTime Czas klatki w sekundach
+     */
+    void update(float deltaTime);
+
+    /**
+     * @brief Sprawdza czy którykolwiek efekt jest aktywny
+     * @return true jeśli łańcuch zmieni obraz
+     */
+    bool hasActiveEffects() const;
+
+    /**
+     * @brief Rozpoczyna rysowanie świata
+     * @param width Szerokość sceny
+     * @param height Wysokość sceny
+     * @return true jeśli świat jest przechwytywany do bitmapy pozaekranowej
+     */
+    bool beginWorld(int width, int height);
+
+    /**
+     * @brief Kończy rysowanie świata, stosuje efekty i rysuje wynik
+     */
+    void endWorld();
+};
+
+#endif // POST_PROCESS_H
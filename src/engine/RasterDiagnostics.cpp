@@ -0,0 +1,334 @@
+﻿#include "RasterDiagnostics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+    ALLEGRO_COLOR rgb(float r, float g, float b) {
+        // al_map_rgba_f nie wymaga zainicjalizowanego systemu Allegro
+        return al_map_rgba_f(r, g, b, 1.0f);
+    }
+
+    // Pomija białe znaki i komentarze w nagłówku PPM
+    void skipPPMWhitespace(std::istream& in) {
+        while (in) {
+            int c = in.peek();
+            if (c == '#') {
+                std::string comment;
+                std::getline(in, comment);
+            }
+            else if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                in.get();
+            }
+            else {
+                break;
+            }
+        }
+    }
+}
+
+RasterDiagnostics::RasterDiagnostics(const std::string& goldenDirectory, int channelTolerance, int iterations)
+    : goldenDirectory(goldenDirectory)
+    , channelTolerance(channelTolerance)
+    , allowedMismatches(0)
+    , iterations(std::max(1, iterations))
+    , maxSlowdown(0.0)
+{
+    buildCatalogue();
+}
+
+void RasterDiagnostics::buildCatalogue() {
+    const Point2D center(FRAME_WIDTH / 2.0f, FRAME_HEIGHT / 2.0f);
+
+    cases.push_back({ "line_octants", [center](PrimitiveRenderer& r) {
+        // Linie we wszystkich oktantach, w tym poziome, pionowe i ukośne
+        r.setColor(rgb(1.0f, 1.0f, 1.0f));
+        for (int i = 0; i < 16; i++) {
+            float angle = i * 3.14159265f / 8.0f;
+            Point2D end(center.getX() + 100.0f * std::cos(angle), center.getY() + 100.0f * std::sin(angle));
+            r.drawLine(center, end);
+        }
+    } });
+
+    cases.push_back({ "line_offscreen", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(1.0f, 0.5f, 0.0f));
+        r.drawLine(Point2D(-50.0f, -50.0f), Point2D(300.0f, 300.0f));
+        r.drawLine(Point2D(-1000.0f, 10.0f), Point2D(1000.0f, 20.0f));
+        r.drawLine(Point2D(300.0f, -10.0f), Point2D(300.0f, 400.0f));
+        r.drawLine(Point2D(40.0f, 40.0f), Point2D(40.0f, 40.0f));
+    } });
+
+    cases.push_back({ "triangle_filled", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.2f, 0.8f, 0.2f));
+        r.drawTriangle(Triangle(20.0f, 20.0f, 230.0f, 60.0f, 90.0f, 220.0f, true));
+    } });
+
+    cases.push_back({ "triangle_flat_edges", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.2f, 0.4f, 1.0f));
+        r.drawTriangle(Triangle(20.0f, 30.0f, 120.0f, 30.0f, 70.0f, 120.0f, true));
+        r.drawTriangle(Triangle(180.0f, 130.0f, 130.0f, 230.0f, 240.0f, 230.0f, true));
+    } });
+
+    cases.push_back({ "triangle_degenerate", [](PrimitiveRenderer& r) {
+        // Trójkąty współliniowe, zredukowane do punktu i do poziomego odcinka
+        r.setColor(rgb(1.0f, 0.2f, 0.2f));
+        r.drawTriangle(Triangle(10.0f, 10.0f, 100.0f, 100.0f, 200.0f, 200.0f, true));
+        r.drawTriangle(Triangle(60.0f, 200.0f, 60.0f, 200.0f, 60.0f, 200.0f, true));
+        r.drawTriangle(Triangle(120.0f, 40.0f, 200.0f, 40.0f, 160.0f, 40.0f, true));
+    } });
+
+    cases.push_back({ "triangle_offscreen", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.9f, 0.9f, 0.2f));
+        r.drawTriangle(Triangle(-100.0f, 50.0f, 200.0f, -80.0f, 300.0f, 300.0f, true));
+        r.drawTriangle(Triangle(400.0f, 400.0f, 500.0f, 420.0f, 450.0f, 600.0f, true));
+    } });
+
+    cases.push_back({ "rectangle_axis", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.6f, 0.3f, 0.9f));
+        r.drawRectangle(Rectangle(40.0f, 40.0f, 120.0f, 80.0f, true));
+        r.drawRectangle(Rectangle(60.0f, 150.0f, 150.0f, 60.0f, false));
+    } });
+
+    cases.push_back({ "rectangle_rotated", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.3f, 0.9f, 0.9f));
+        Rectangle rectangle(70.0f, 90.0f, 120.0f, 60.0f, true);
+        rectangle.rotate(30.0f, Point2D(130.0f, 120.0f));
+        r.drawRectangle(rectangle);
+    } });
+
+    cases.push_back({ "rectangle_offscreen", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.8f, 0.5f, 0.3f));
+        r.drawRectangle(Rectangle(-60.0f, 200.0f, 400.0f, 120.0f, true));
+        r.drawRectangle(Rectangle(-500.0f, -500.0f, 100.0f, 100.0f, true));
+    } });
+
+    cases.push_back({ "circle_small", [](PrimitiveRenderer& r) {
+        r.setColor(rgb(1.0f, 1.0f, 1.0f));
+        r.drawCircle(Circle(30.0f, 30.0f, 0.0f, true));
+        r.drawCircle(Circle(60.0f, 30.0f, 1.0f, true));
+        r.drawCircle(Circle(90.0f, 30.0f, 5.0f, false));
+        r.drawCircle(Circle(130.0f, 30.0f, 12.0f, true));
+    } });
+
+    cases.push_back({ "circle_large", [center](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.9f, 0.3f, 0.5f));
+        r.drawCircle(Circle(center, 100.0f, true));
+        r.setColor(rgb(1.0f, 1.0f, 1.0f));
+        r.drawCircle(Circle(center, 120.0f, false));
+    } });
+
+    cases.push_back({ "circle_huge", [center](PrimitiveRenderer& r) {
+        // Okrąg znacznie większy niż bufor - sprawdza koszt obcinania
+        r.setColor(rgb(0.1f, 0.5f, 0.1f));
+        r.drawCircle(Circle(center, 2000.0f, true));
+        r.setColor(rgb(1.0f, 1.0f, 0.0f));
+        r.drawCircle(Circle(-2900.0f, center.getY(), 3000.0f, false));
+    } });
+
+    cases.push_back({ "circle_offscreen", [center](PrimitiveRenderer& r) {
+        r.setColor(rgb(0.3f, 0.3f, 1.0f));
+        r.drawCircle(Circle(300.0f, center.getY(), 60.0f, true));
+        r.drawCircle(Circle(-1000.0f, -1000.0f, 50.0f, true));
+    } });
+}
+
+std::string RasterDiagnostics::goldenPath(const std::string& name) const {
+    return goldenDirectory + "/" + name + ".ppm";
+}
+
+std::string RasterDiagnostics::timingsPath() const {
+    return goldenDirectory + "/timings.txt";
+}
+
+double RasterDiagnostics::measure(const RasterCase& rasterCase, SoftwareRenderTarget& frame, PrimitiveRenderer& renderer) const {
+    // Mierzony jest wyłącznie czas rysowania (bez czyszczenia bufora)
+    frame.clear(rgb(0.0f, 0.0f, 0.0f));
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        rasterCase.draw(renderer);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double total = std::chrono::duration<double, std::micro>(end - start).count();
+    return total / iterations;
+}
+
+void RasterDiagnostics::compare(const SoftwareRenderTarget& frame, RasterCaseResult& result) const {
+    std::vector<uint8_t> golden;
+    int width = 0;
+    int height = 0;
+    if (!loadPPM(goldenPath(result.name), golden, width, height)) {
+        result.goldenMissing = true;
+        return;
+    }
+
+    if (width != frame.getWidth() || height != frame.getHeight()) {
+        result.mismatchedPixels = frame.getWidth() * frame.getHeight();
+        result.maxChannelDelta = 255;
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = frame.getRow(y);
+        const uint8_t* expected = golden.data() + static_cast<size_t>(y) * width * 3;
+        for (int x = 0; x < width; x++) {
+            int delta = 0;
+            for (int c = 0; c < 3; c++) {
+                delta = std::max(delta, std::abs(row[x * 4 + c] - expected[x * 3 + c]));
+            }
+            result.maxChannelDelta = std::max(result.maxChannelDelta, delta);
+            if (delta > channelTolerance) {
+                result.mismatchedPixels++;
+            }
+        }
+    }
+}
+
+bool RasterDiagnostics::run(bool record) {
+    results.clear();
+
+    // Renderer działa bez wyświetlacza - piksele trafiają wyłącznie do bufora
+    PrimitiveRenderer::initialize(nullptr);
+    PrimitiveRenderer* renderer = PrimitiveRenderer::getInstance();
+    RenderTarget* previousTarget = renderer->getRenderTarget();
+
+    SoftwareRenderTarget frame(FRAME_WIDTH, FRAME_HEIGHT);
+    renderer->setRenderTarget(&frame);
+
+    std::vector<std::pair<std::string, double>> baseline;
+    if (record) {
+        // Katalog wzorców może jeszcze nie istnieć (pierwszy zapis)
+        std::error_code error;
+        std::filesystem::create_directories(goldenDirectory, error);
+    }
+    else {
+        loadTimings(baseline);
+    }
+
+    bool allPassed = true;
+    for (const RasterCase& rasterCase : cases) {
+        RasterCaseResult result;
+        result.name = rasterCase.name;
+        result.passed = true;
+        result.goldenMissing = false;
+        result.mismatchedPixels = 0;
+        result.maxChannelDelta = 0;
+        result.baselineMicroseconds = 0.0;
+
+        // Pomiar czasu, a następnie jedno czyste renderowanie do porównania
+        result.averageMicroseconds = measure(rasterCase, frame, *renderer);
+        frame.clear(rgb(0.0f, 0.0f, 0.0f));
+        rasterCase.draw(*renderer);
+
+        if (record) {
+            result.passed = frame.savePPM(goldenPath(result.name));
+        }
+        else {
+            compare(frame, result);
+            result.passed = !result.goldenMissing && result.mismatchedPixels <= allowedMismatches;
+
+            for (const auto& entry : baseline) {
+                if (entry.first == result.name) {
+                    result.baselineMicroseconds = entry.second;
+                }
+            }
+            if (maxSlowdown > 0.0 && result.baselineMicroseconds > 0.0 &&
+                result.averageMicroseconds > result.baselineMicroseconds * maxSlowdown) {
+                result.passed = false;
+            }
+        }
+
+        allPassed = allPassed && result.passed;
+        results.push_back(result);
+    }
+
+    renderer->setRenderTarget(previousTarget);
+
+    if (record && !saveTimings()) {
+        allPassed = false;
+    }
+    return allPassed;
+}
+
+bool RasterDiagnostics::loadTimings(std::vector<std::pair<std::string, double>>& timings) const {
+    std::ifstream in(timingsPath());
+    if (!in) {
+        return false;
+    }
+
+    std::string name;
+    double microseconds;
+    while (in >> name >> microseconds) {
+        timings.emplace_back(name, microseconds);
+    }
+    return true;
+}
+
+bool RasterDiagnostics::saveTimings() const {
+    std::ofstream out(timingsPath());
+    if (!out) {
+        return false;
+    }
+
+    out << std::fixed << std::setprecision(2);
+    for (const RasterCaseResult& result : results) {
+        out << result.name << " " << result.averageMicroseconds << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void RasterDiagnostics::printReport(std::ostream& out) const {
+    int failed = 0;
+    out << std::fixed << std::setprecision(1);
+    for (const RasterCaseResult& result : results) {
+        out << (result.passed ? "[ OK ] " : "[FAIL] ") << std::left << std::setw(22) << result.name
+            << std::right << std::setw(10) << result.averageMicroseconds << " us";
+
+        if (result.baselineMicroseconds > 0.0) {
+            out << " (baseline " << result.baselineMicroseconds << " us, "
+                << std::setprecision(2) << result.averageMicroseconds / result.baselineMicroseconds
+                << "x)" << std::setprecision(1);
+        }
+        if (result.goldenMissing) {
+            out << " - missing golden image";
+        }
+        else if (result.mismatchedPixels > 0) {
+            out << " - " << result.mismatchedPixels << " pixels differ, max delta " << result.maxChannelDelta;
+        }
+        out << "\n";
+
+        if (!result.passed) failed++;
+    }
+    out << results.size() - failed << "/" << results.size() << " raster cases passed\n";
+}
+
+bool RasterDiagnostics::loadPPM(const std::string& path, std::vector<uint8_t>& rgb, int& width, int& height) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    std::string magic;
+    int maxValue = 0;
+    in >> magic;
+    skipPPMWhitespace(in);
+    in >> width;
+    skipPPMWhitespace(in);
+    in >> height;
+    skipPPMWhitespace(in);
+    in >> maxValue;
+    in.get(); // Pojedynczy biały znak przed danymi
+
+    if (magic != "P6" || maxValue != 255 || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    rgb.resize(static_cast<size_t>(width) * height * 3);
+    in.read(reinterpret_cast<char*>(rgb.data()), rgb.size());
+    return static_cast<size_t>(in.gcount()) == rgb.size();
+}
@@ -0,0 +1,129 @@
+﻿/**
+ * @file RasterDiagnostics.h
+ * @brief Regresja obrazów i pomiar wydajności rasteryzera prymitywów
+ *
+ * RasterDiagnostics renderuje katalog figur (linie, trójkąty zdegenerowane,
+ * duże okręgi, obrócone prostokąty, geometria poza ekranem) do bufora
+ * SoftwareRenderTarget bez otwierania okna. Każdy wynik jest porównywany
+ * z wzorcowym obrazem PPM, a czas renderowania z zapisanymi pomiarami,
+ * dzięki czemu zmiany w PrimitiveRenderer nie mogą niezauważenie zmienić
+ * pikseli ani spowolnić rysowania.
+ */
+
+#ifndef RASTER_DIAGNOSTICS_H
+#define RASTER_DIAGNOSTICS_H
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "PrimitiveRenderer.h"
+#include "RenderTarget.h"
+
+ /**
+  * @brief Wynik pojedynczego przypadku testowego rasteryzera
+  */
+struct RasterCaseResult {
+    std::string name;            ///< Nazwa przypadku (nazwa pliku wzorca)
+    bool passed;                 ///< Czy przypadek przeszedł (piksele i czas)
+    bool goldenMissing;          ///< Brak obrazu wzorcowego
+    int mismatchedPixels;        ///< Liczba pikseli poza tolerancją
+    int maxChannelDelta;         ///< Największa różnica kanału koloru
+    double averageMicroseconds;  ///< Średni czas renderowania przypadku
+    double baselineMicroseconds; ///< Zapisany czas odniesienia (0 = brak)
+};
+
+/**
+ * @brief Zestaw regresji obrazów i pomiarów wydajności rasteryzera
+ *
+ * W trybie zapisu (record) obrazy i czasy są zapisywane jako nowe wzorce
+ * w katalogu wzorców. W trybie sprawdzania przypadek nie przechodzi, gdy
+ * więcej pikseli niż dozwolone różni się o więcej niż tolerancja.
+ * Czasy są domyślnie tylko raportowane (razem ze stosunkiem do czasu
+ * odniesienia) - zapisane pomiary zwykle pochodzą z innej maszyny.
+ * setMaxSlowdown włącza bramkę czasu, gdy odniesienie zapisano na tej
+ * samej maszynie.
+ */
+class RasterDiagnostics {
+public:
+    static const int FRAME_WIDTH = 256;    ///< Szerokość bufora testowego
+    static const int FRAME_HEIGHT = 256;   ///< Wysokość bufora testowego
+
+private:
+    /**
+     * @brief Przypadek testowy - nazwa i funkcja rysująca
+     */
+    struct RasterCase {
+        std::string name;
+        std::function<void(PrimitiveRenderer&)> draw;
+    };
+
+    std::string goldenDirectory;            ///< Katalog z obrazami wzorcowymi
+    int channelTolerance;                   ///< Dopuszczalna różnica kanału (0-255)
+    int allowedMismatches;                  ///< Dopuszczalna liczba różniących się pikseli
+    int iterations;                         ///< Liczba powtórzeń przy pomiarze czasu
+    double maxSlowdown;                     ///< Dopuszczalne spowolnienie względem odniesienia
+    std::vector<RasterCase> cases;          ///< Katalog przypadków
+    std::vector<RasterCaseResult> results;  ///< Wyniki ostatniego uruchomienia
+
+    void buildCatalogue();
+    double measure(const RasterCase& rasterCase, SoftwareRenderTarget& frame, PrimitiveRenderer& renderer) const;
+    void compare(const SoftwareRenderTarget& frame, RasterCaseResult& result) const;
+    std::string goldenPath(const std::string& name) const;
+    std::string timingsPath() const;
+    bool loadTimings(std::vector<std::pair<std::string, double>>& timings) const;
+    bool saveTimings() const;
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param goldenDirectory Katalog z obrazami wzorcowymi i plikiem czasów
+     * @param channelTolerance Dopuszczalna różnica pojedynczego kanału koloru
+     * @param iterations Liczba powtórzeń renderowania przy pomiarze czasu
+     */
+    RasterDiagnostics(const std::string& goldenDirectory, int channelTolerance = 0, int iterations = 50);
+
+    /**
+     * @brief Ustawia dopuszczalną liczbę różniących się pikseli
+     * @param count Liczba pikseli
+     */
+    void setAllowedMismatches(int count) { allowedMismatches = count; }
+
+    /**
+     * @brief Ustawia dopuszczalne spowolnienie względem zapisanych czasów
+     * @param factor Mnożnik czasu (wartość <= 0 - czasy tylko raportowane, domyślnie)
+     */
+    void setMaxSlowdown(float factor) { maxSlowdown = factor; }
+
+    /**
+     * @brief Uruchamia wszystkie przypadki
+     * @param record true - zapisuje nowe wzorce, false - porównuje z istniejącymi
+     * @return true jeśli wszystkie przypadki przeszły (lub wzorce zapisano)
+     */
+    bool run(bool record);
+
+    /**
+     * @brief Pobiera wyniki ostatniego uruchomienia
+     * @return Lista wyników
+     */
+    const std::vector<RasterCaseResult>& getResults() const { return results; }
+
+    /**
+     * @brief Wypisuje raport z ostatniego uruchomienia
+     * @param out Strumień wyjściowy
+     */
+    void printReport(std::ostream& out) const;
+
+    /**
+     * @brief Wczytuje obraz PPM (P6, 8 bitów na kanał)
+     * @param path Ścieżka pliku
+     * @param rgb Wyjściowe piksele RGB
+     * @param width Wyjściowa szerokość
+     * @param height Wyjściowa wysokość
+     * @return true jeśli wczytanie się powiodło
+     */
+    static bool loadPPM(const std::string& path, std::vector<uint8_t>& rgb, int& width, int& height);
+};
+
+#endif // RASTER_DIAGNOSTICS_H
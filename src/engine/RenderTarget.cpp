@@ -0,0 +1,220 @@
+﻿#include "RenderTarget.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// RenderTarget
+void RenderTarget::fillSpan(int y, int x1, int x2, ALLEGRO_COLOR color) {
+    if (x1 > x2) std::swap(x1, x2);
+    for (int x = x1; x <= x2; x++) {
+        putPixel(x, y, color);
+    }
+}
+
+// BitmapRenderTarget
+BitmapRenderTarget::BitmapRenderTarget(ALLEGRO_BITMAP* bitmap)
+    : bitmap(bitmap)
+    , activeBitmap(nullptr)
+    , prevTarget(nullptr)
+    , width(0)
+    , height(0)
+{
+}
+
+void BitmapRenderTarget::begin() {
+    prevTarget = nullptr;
+    if (bitmap) {
+        prevTarget = al_get_target_bitmap();
+        if (prevTarget != bitmap) {
+            al_set_target_bitmap(bitmap);
+        }
+        activeBitmap = bitmap;
+    }
+    else {
+        activeBitmap = al_get_target_bitmap();
+    }
+
+    // Rozmiar celu odczytywany raz na serię rysowania
+    width = activeBitmap ? al_get_bitmap_width(activeBitmap) : 0;
+    height = activeBitmap ? al_get_bitmap_height(activeBitmap) : 0;
+}
+
+void BitmapRenderTarget::end() {
+    if (prevTarget && prevTarget != activeBitmap) {
+        al_set_target_bitmap(prevTarget);
+    }
+    prevTarget = nullptr;
+    activeBitmap = nullptr;
+}
+
+void BitmapRenderTarget::putPixel(int x, int y, ALLEGRO_COLOR color) {
+    if (x >= 0 && x < width && y >= 0 && y < height) {
+        al_draw_pixel(x, y, color);
+    }
+}
+
+void BitmapRenderTarget::clear(ALLEGRO_COLOR color) {
+    al_clear_to_color(color);
+}
+
+// SoftwareRenderTarget
+SoftwareRenderTarget::SoftwareRenderTarget(int width, int height)
+    : pixels(nullptr)
+    , width(0)
+    , height(0)
+    , stride(0)
+{
+    resize(width, height);
+}
+
+void SoftwareRenderTarget::resize(int newWidth, int newHeight) {
+    width = std::max(0, newWidth);
+    height = std::max(0, newHeight);
+
+    // Stride zaokrąglony w górę do wielokrotności wyrównania
+    stride = ((width * 4 + ROW_ALIGNMENT - 1) / ROW_ALIGNMENT) * ROW_ALIGNMENT;
+    storage.assign(static_cast<size_t>(stride) * height + ROW_ALIGNMENT, 0);
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(storage.data());
+    uintptr_t aligned = (base + ROW_ALIGNMENT - 1) & ~static_cast<uintptr_t>(ROW_ALIGNMENT - 1);
+    pixels = storage.data() + (aligned - base);
+}
+
+uint32_t SoftwareRenderTarget::packColor(ALLEGRO_COLOR color) {
+    auto toByte = [](float value) -> uint32_t {
+        value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+        return static_cast<uint32_t>(value * 255.0f + 0.5f);
+    };
+
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(toByte(color.r)),
+        static_cast<uint8_t>(toByte(color.g)),
+        static_cast<uint8_t>(toByte(color.b)),
+        static_cast<uint8_t>(toByte(color.a))
+    };
+    uint32_t packed;
+    std::memcpy(&packed, bytes, sizeof(packed));
+    return packed;
+}
+
+void SoftwareRenderTarget::putPixel(int x, int y, ALLEGRO_COLOR color) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+
+    uint8_t* dst = getRow(y) + x * 4;
+    if (color.a >= 1.0f) {
+        uint32_t packed = packColor(color);
+        std::memcpy(dst, &packed, sizeof(packed));
+        return;
+    }
+
+    // Mieszanie "source over" dla kolorów półprzezroczystych
+    float a = color.a < 0.0f ? 0.0f : color.a;
+    float src[3] = { color.r, color.g, color.b };
+    for (int c = 0; c < 3; c++) {
+        float value = src[c] * 255.0f * a + dst[c] * (1.0f - a);
+        dst[c] = static_cast<uint8_t>(std::min(255.0f, value + 0.5f));
+    }
+    dst[3] = static_cast<uint8_t>(std::min(255.0f, a * 255.0f + dst[3] * (1.0f - a) + 0.5f));
+}
+
+void SoftwareRenderTarget::fillSpan(int y, int x1, int x2, ALLEGRO_COLOR color) {
+    if (y < 0 || y >= height) return;
+    if (x1 > x2) std::swap(x1, x2);
+
+    x1 = std::max(x1, 0);
+    x2 = std::min(x2, width - 1);
+    if (x1 > x2) return;
+
+    if (color.a < 1.0f) {
+        RenderTarget::fillSpan(y, x1, x2, color);
+        return;
+    }
+
+    // Nieprzezroczysty odcinek - zapis całych słów bez obcinania per piksel
+    uint32_t packed = packColor(color);
+    uint8_t* row = getRow(y);
+    for (int x = x1; x <= x2; x++) {
+        std::memcpy(row + x * 4, &packed, sizeof(packed));
+    }
+}
+
+void SoftwareRenderTarget::clear(ALLEGRO_COLOR color) {
+    uint32_t packed = packColor(color);
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = getRow(y);
+        for (int x = 0; x < width; x++) {
+            std::memcpy(row + x * 4, &packed, sizeof(packed));
+        }
+    }
+}
+
+uint32_t SoftwareRenderTarget::getPixel(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) return 0;
+
+    uint32_t packed;
+    std::memcpy(&packed, getRow(y) + x * 4, sizeof(packed));
+    return packed;
+}
+
+bool SoftwareRenderTarget::copyToBitmap(ALLEGRO_BITMAP* bitmap) const {
+    if (!bitmap || al_get_bitmap_width(bitmap) != width || al_get_bitmap_height(bitmap) != height) {
+        return false;
+    }
+
+    // Format ABGR_8888_LE ma w pamięci kolejność bajtów R, G, B, A - jak bufor
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+    if (!region) {
+        return false;
+    }
+
+    for (int y = 0; y < height; y++) {
+        uint8_t* dst = static_cast<uint8_t*>(region->data) + y * region->pitch;
+        std::memcpy(dst, getRow(y), static_cast<size_t>(width) * 4);
+    }
+
+    al_unlock_bitmap(bitmap);
+    return true;
+}
+
+bool SoftwareRenderTarget::copyFromBitmap(ALLEGRO_BITMAP* bitmap) {
+    if (!bitmap || al_get_bitmap_width(bitmap) != width || al_get_bitmap_height(bitmap) != height) {
+        return false;
+    }
+
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    if (!region) {
+        return false;
+    }
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* src = static_cast<const uint8_t*>(region->data) + y * region->pitch;
+        std::memcpy(getRow(y), src, static_cast<size_t>(width) * 4);
+    }
+
+    al_unlock_bitmap(bitmap);
+    return true;
+}
+
+bool SoftwareRenderTarget::savePPM(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+
+    std::vector<uint8_t> line(static_cast<size_t>(width) * 3);
+    bool ok = true;
+    for (int y = 0; y < height && ok; y++) {
+        const uint8_t* row = getRow(y);
+        for (int x = 0; x < width; x++) {
+            line[x * 3 + 0] = row[x * 4 + 0];
+            line[x * 3 + 1] = row[x * 4 + 1];
+            line[x * 3 + 2] = row[x * 4 + 2];
+        }
+        ok = std::fwrite(line.data(), 1, line.size(), file) == line.size();
+    }
+
+    std::fclose(file);
+    return ok;
+}
@@ -0,0 +1,206 @@
+﻿/**
+ * @file RenderTarget.h
+ * @brief Abstrakcja celu renderowania dla PrimitiveRenderer
+ *
+ * RenderTarget oddziela algorytmy rasteryzacji od miejsca, do którego
+ * trafiają piksele. BitmapRenderTarget rysuje do bitmapy Allegro
+ * (domyślnie do aktualnego celu), a SoftwareRenderTarget do zwykłego
+ * bufora w pamięci RAM (RGBA8, wyrównane wiersze), co pozwala używać
+ * rasteryzera bez okna - np. do testów wydajności, generowania obrazów
+ * i wypiekania tekstur offline.
+ */
+
+#ifndef RENDER_TARGET_H
+#define RENDER_TARGET_H
+
+#include <allegro5/allegro.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+ /**
+  * @brief Interfejs celu renderowania pikseli
+  *
+  * Współrzędne są w pikselach celu. Implementacje odpowiadają za
+  * obcinanie pikseli leżących poza obszarem celu.
+  */
+class RenderTarget {
+public:
+    virtual ~RenderTarget() = default;
+
+    /**
+     * @brief Przygotowuje cel do rysowania (wywoływane przed serią operacji)
+     */
+    virtual void begin() {}
+
+    /**
+     * @brief Kończy serię operacji rysowania
+     */
+    virtual void end() {}
+
+    /**
+     * @brief Pobiera szerokość celu
+     * @return Szerokość w pikselach
+     */
+    virtual int getWidth() const = 0;
+
+    /**
+     * @brief Pobiera wysokość celu
+     * @return Wysokość w pikselach
+     */
+    virtual int getHeight() const = 0;
+
+    /**
+     * @brief Rysuje pojedynczy piksel (z obcinaniem)
+     * @param x Współrzędna X
+     * @param y Współrzędna Y
+     * @param color Kolor piksela
+     */
+    virtual void putPixel(int x, int y, ALLEGRO_COLOR color) = 0;
+
+    /**
+     * @brief Wypełnia poziomy odcinek [x1, x2] w wierszu y (z obcinaniem)
+     * @param y Wiersz
+     * @param x1 Początek odcinka
+     * @param x2 Koniec odcinka (włącznie)
+     * @param color Kolor wypełnienia
+     *
+     * Domyślna implementacja rysuje odcinek piksel po pikselu.
+     */
+    virtual void fillSpan(int y, int x1, int x2, ALLEGRO_COLOR color);
+
+    /**
+     * @brief Czyści cały cel zadanym kolorem
+     * @param color Kolor czyszczenia
+     */
+    virtual void clear(ALLEGRO_COLOR color) = 0;
+};
+
+/**
+ * @brief Cel renderowania oparty o bitmapę Allegro
+ *
+ * Bez podanej bitmapy rysuje do aktualnego celu Allegro (zachowanie
+ * zgodne z wcześniejszym PrimitiveRenderer). Rozmiar celu jest
+ * odczytywany raz w begin(), a nie przy każdym pikselu.
+ */
+class BitmapRenderTarget : public RenderTarget {
+private:
+    ALLEGRO_BITMAP* bitmap;        ///< Docelowa bitmapa (nullptr = aktualny cel Allegro)
+    ALLEGRO_BITMAP* activeBitmap;  ///< Bitmapa używana w bieżącej serii rysowania
+    ALLEGRO_BITMAP* prevTarget;    ///< Poprzedni cel Allegro (przywracany w end())
+    int width;                     ///< Szerokość aktywnej bitmapy
+    int height;                    ///< Wysokość aktywnej bitmapy
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param bitmap Docelowa bitmapa lub nullptr dla aktualnego celu Allegro
+     */
+    explicit BitmapRenderTarget(ALLEGRO_BITMAP* bitmap = nullptr);
+
+    void begin() override;
+    void end() override;
+    int getWidth() const override { return width; }
+    int getHeight() const override { return height; }
+    void putPixel(int x, int y, ALLEGRO_COLOR color) override;
+    void clear(ALLEGRO_COLOR color) override;
+
+    /**
+     * @brief Zmienia docelową bitmapę
+     * @param newBitmap Bitmapa lub nullptr dla aktualnego celu Allegro
+     */
+    void setBitmap(ALLEGRO_BITMAP* newBitmap) { bitmap = newBitmap; }
+};
+
+/**
+ * @brief Programowy bufor ramki w pamięci RAM
+ *
+ * Piksele są zapisane jako RGBA8 (bajty w kolejności R, G, B, A).
+ * Każdy wiersz zaczyna się pod adresem wyrównanym do ROW_ALIGNMENT bajtów,
+ * a odległość między wierszami (stride) jest wielokrotnością wyrównania.
+ * Nie wymaga okna ani kontekstu graficznego.
+ */
+class SoftwareRenderTarget : public RenderTarget {
+public:
+    static const int ROW_ALIGNMENT = 64;   ///< Wyrównanie wierszy w bajtach
+
+private:
+    std::vector<uint8_t> storage;   ///< Pamięć bufora (z zapasem na wyrównanie)
+    uint8_t* pixels;                ///< Wyrównany początek pierwszego wiersza
+    int width;                      ///< Szerokość w pikselach
+    int height;                     ///< Wysokość w pikselach
+    int stride;                     ///< Odległość między wierszami w bajtach
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param width Szerokość bufora
+     * @param height Wysokość bufora
+     */
+    SoftwareRenderTarget(int width, int height);
+
+    /**
+     * @brief Zmienia rozmiar bufora (zawartość nie jest zachowywana)
+     * @param newWidth Nowa szerokość
+     * @param newHeight Nowa wysokość
+     */
+    void resize(int newWidth, int newHeight);
+
+    int getWidth() const override { return width; }
+    int getHeight() const override { return height; }
+    void putPixel(int x, int y, ALLEGRO_COLOR color) override;
+    void fillSpan(int y, int x1, int x2, ALLEGRO_COLOR color) override;
+    void clear(ALLEGRO_COLOR color) override;
+
+    /**
+     * @brief Pobiera odległość między wierszami
+     * @return Stride w bajtach
+     */
+    int getStride() const { return stride; }
+
+    /**
+     * @brief Pobiera wskaźnik na początek wiersza
+     * @param y Numer wiersza
+     * @return Wskaźnik na pierwszy bajt wiersza
+     */
+    uint8_t* getRow(int y) { return pixels + static_cast<size_t>(y) * stride; }
+    const uint8_t* getRow(int y) const { return pixels + static_cast<size_t>(y) * stride; }
+
+    /**
+     * @brief Odczytuje piksel jako spakowane RGBA8
+     * @param x Współrzędna X
+     * @param y Współrzędna Y
+     * @return Piksel (bajty R, G, B, A w kolejności pamięci) lub 0 poza buforem
+     */
+    uint32_t getPixel(int x, int y) const;
+
+    /**
+     * @brief Konwertuje kolor Allegro do spakowanego RGBA8
+     * @param color Kolor
+     * @return Piksel w formacie bufora
+     */
+    static uint32_t packColor(ALLEGRO_COLOR color);
+
+    /**
+     * @brief Kopiuje zawartość bufora do bitmapy Allegro
+     * @param bitmap Bitmapa docelowa o tym samym rozmiarze
+     * @return true jeśli kopiowanie się powiodło
+     */
+    bool copyToBitmap(ALLEGRO_BITMAP* bitmap) const;
+
+    /**
+     * @brief Kopiuje zawartość bitmapy Allegro do bufora
+     * @param bitmap Bitmapa źródłowa o tym samym rozmiarze
+     * @return true jeśli kopiowanie się powiodło
+     */
+    bool copyFromBitmap(ALLEGRO_BITMAP* bitmap);
+
+    /**
+     * @brief Zapisuje bufor do pliku PPM (P6, bez kanału alfa)
+     * @param path Ścieżka pliku
+     * @return true jeśli zapis się powiódł
+     */
+    bool savePPM(const std::string& path) const;
+};
+
+#endif // RENDER_TARGET_H
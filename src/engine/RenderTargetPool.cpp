@@ -0,0 +1,118 @@
+﻿#include "RenderTargetPool.h"
+
+RenderTargetPool::RenderTargetPool(unsigned long maxIdleFrames)
+    : frame(0)
+    , maxIdleFrames(maxIdleFrames)
+{
+}
+
+RenderTargetPool::~RenderTargetPool() {
+    clear();
+}
+
+ALLEGRO_BITMAP* RenderTargetPool::acquireBitmap(int width, int height, int flags) {
+    if (flags < 0) {
+        flags = al_get_new_bitmap_flags();
+    }
+
+    for (BitmapEntry& entry : bitmaps) {
+        if (!entry.inUse && entry.width == width && entry.height == height && entry.flags == flags) {
+            entry.inUse = true;
+            entry.lastUsed = frame;
+            return entry.bitmap;
+        }
+    }
+
+    int prevFlags = al_get_new_bitmap_flags();
+    al_set_new_bitmap_flags(flags);
+    ALLEGRO_BITMAP* bitmap = al_create_bitmap(width, height);
+    al_set_new_bitmap_flags(prevFlags);
+
+    if (!bitmap) {
+        return nullptr;
+    }
+
+    BitmapEntry entry;
+    entry.bitmap = bitmap;
+    entry.width = width;
+    entry.height = height;
+    entry.flags = flags;
+    entry.inUse = true;
+    entry.lastUsed = frame;
+    bitmaps.push_back(entry);
+    return bitmap;
+}
+
+void RenderTargetPool::releaseBitmap(ALLEGRO_BITMAP* bitmap) {
+    for (BitmapEntry& entry : bitmaps) {
+        if (entry.bitmap == bitmap) {
+            entry.inUse = false;
+            return;
+        }
+    }
+}
+
+SoftwareRenderTarget* RenderTargetPool::acquireSoftware(int width, int height) {
+    for (SoftwareEntry& entry : software) {
+        if (!entry.inUse && entry.target->getWidth() == width && entry.target->getHeight() == height) {
+            entry.inUse = true;
+            entry.lastUsed = frame;
+            return entry.target;
+        }
+    }
+
+    SoftwareEntry entry;
+    entry.target = new SoftwareRenderTarget(width, height);
+    entry.inUse = true;
+    entry.lastUsed = frame;
+    software.push_back(entry);
+    return entry.target;
+}
+
+void RenderTargetPool::releaseSoftware(SoftwareRenderTarget* target) {
+    for (SoftwareEntry& entry : software) {
+        if (entry.target == target) {
+            entry.inUse = false;
+            return;
+        }
+    }
+}
+
+void RenderTargetPool::endFrame() {
+    frame++;
+
+    // Zwalnianie celów, które nie były używane od dłuższego czasu (np. po zmianie rozdzielczości)
+    for (size_t i = 0; i < bitmaps.size();) {
+        if (!bitmaps[i].inUse && frame - bitmaps[i].lastUsed > maxIdleFrames) {
+            al_destroy_bitmap(bitmaps[i].bitmap);
+            bitmaps[i] = bitmaps.back();
+            bitmaps.pop_back();
+        }
+        else {
+            i++;
+        }
+    }
+
+    for (size_t i = 0; i < software.size();) {
+        if (!software[i].inUse && frame - software[i].lastUsed > maxIdleFrames) {
+            delete software[i].target;
+            software[i] = software.back();
+            software.pop_back();
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+void RenderTargetPool::clear() {
+    for (BitmapEntry& entry : bitmaps) {
+        al_destroy_bitmap(entry.bitmap);
+    }
+    bitmaps.clear();
+
+    for (SoftwareEntry& entry : software) {
+        delete entry.target;
+    }
+    software.clear();
+}
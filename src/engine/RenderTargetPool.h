@@ -0,0 +1,107 @@
+﻿/**
+ * @file RenderTargetPool.h
+ * @brief Pula wielokrotnie używanych celów renderowania
+ *
+ * Tworzenie bitmap i buforów w każdej klatce jest kosztowne, dlatego
+ * cele pośrednie (scena świata, bufory post-processingu) są pobierane
+ * z puli i oddawane do niej po użyciu. Cel o tym samym rozmiarze jest
+ * w kolejnej klatce zwracany ponownie bez alokacji.
+ */
+
+#ifndef RENDER_TARGET_POOL_H
+#define RENDER_TARGET_POOL_H
+
+#include <allegro5/allegro.h>
+#include <vector>
+#include "RenderTarget.h"
+
+ /**
+  * @brief Pula bitmap Allegro i buforów programowych
+  */
+class RenderTargetPool {
+private:
+    /**
+     * @brief Wpis puli bitmap
+     */
+    struct BitmapEntry {
+        ALLEGRO_BITMAP* bitmap;  ///< Bitmapa
+        int width;               ///< Szerokość
+        int height;              ///< Wysokość
+        int flags;               ///< Flagi użyte przy tworzeniu
+        bool inUse;              ///< Czy bitmapa jest wypożyczona
+        unsigned long lastUsed;  ///< Klatka ostatniego wypożyczenia
+    };
+
+    /**
+     * @brief Wpis puli buforów programowych
+     */
+    struct SoftwareEntry {
+        SoftwareRenderTarget* target;  ///< Bufor
+        bool inUse;                    ///< Czy bufor jest wypożyczony
+        unsigned long lastUsed;        ///< Klatka ostatniego wypożyczenia
+    };
+
+    std::vector<BitmapEntry> bitmaps;      ///< Bitmapy w puli
+    std::vector<SoftwareEntry> software;   ///< Bufory programowe w puli
+    unsigned long frame;                   ///< Licznik klatek
+    unsigned long maxIdleFrames;           ///< Po ilu klatkach nieużywany cel jest zwalniany
+
+    // Zablokowanie kopiowania (pula posiada zasoby)
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param maxIdleFrames Liczba klatek, po której nieużywany cel jest zwalniany
+     */
+    explicit RenderTargetPool(unsigned long maxIdleFrames = 120);
+    ~RenderTargetPool();
+
+    /**
+     * @brief Wypożycza bitmapę o zadanym rozmiarze
+     * @param width Szerokość
+     * @param height Wysokość
+     * @param flags Flagi bitmapy (domyślnie aktualne flagi nowych bitmap)
+     * @return Bitmapa lub nullptr gdy nie udało się jej utworzyć
+     */
+    ALLEGRO_BITMAP* acquireBitmap(int width, int height, int flags = -1);
+
+    /**
+     * @brief Oddaje bitmapę do puli
+     * @param bitmap Bitmapa wypożyczona przez acquireBitmap
+     */
+    void releaseBitmap(ALLEGRO_BITMAP* bitmap);
+
+    /**
+     * @brief Wypożycza bufor programowy o zadanym rozmiarze
+     * @param width Szerokość
+     * @param height Wysokość
+     * @return Bufor (własność pozostaje w puli)
+     */
+    SoftwareRenderTarget* acquireSoftware(int width, int height);
+
+    /**
+     * @brief Oddaje bufor programowy do puli
+     * @param target Bufor wypożyczony przez acquireSoftware
+     */
+    void releaseSoftware(SoftwareRenderTarget* target);
+
+    /**
+     * @brief Kończy klatkę - zwalnia cele nieużywane dłużej niż maxIdleFrames
+     */
+    void endFrame();
+
+    /**
+     * @brief Zwalnia wszystkie cele (także wypożyczone)
+     */
+    void clear();
+
+    /**
+     * @brief Pobiera liczbę bitmap w puli
+     * @return Liczba bitmap
+     */
+    size_t getBitmapCount() const { return bitmaps.size(); }
+};
+
+#endif // RENDER_TARGET_POOL_H
@@ -0,0 +1,100 @@
+﻿/**
+ * @file SimMath.h
+ * @brief Funkcje matematyczne symulacji z opcjonalnym trybem deterministycznym
+ *
+ * Stan symulacji - współrzędne Point2D, prędkości encji, całkowanie ruchu
+ * i testy CollisionManager - jest typu SimMath::Scalar, a iloczyny (kwadraty
+ * odległości, iloczyny skalarne) typu WideScalar. Domyślnie oba to float,
+ * trygonometria korzysta z przybliżeń FastMath (Precision::HIGH), a sqrt
+ * z <cmath>.
+ *
+ * Po zdefiniowaniu PGK_DETERMINISTIC_SIM (w ustawieniach preprocesora
+ * projektu) Scalar to Fixed (Q16.16), a WideScalar to FixedWide (Q32.32).
+ * Krok symulacji nie wykonuje wtedy arytmetyki float - przy stałym
+ * deltaTime i tych samych wejściach daje te same bity na każdej maszynie
+ * i kompilatorze (powtórki, lockstep). Testy kolizji zakładają współrzędne
+ * z zakresu [-16384, 16384).
+ *
+ * Float pozostaje w renderowaniu i w jednorazowym budowaniu geometrii mapy
+ * (obroty i skalowanie kształtów przez Mat2x3). Wynik jest zaokrąglany do
+ * Scalar przy zapisie w Point2D i jest powtarzalny przy /fp:precise bez
+ * kontrakcji do FMA (domyślne ustawienie MSVC).
+ */
+
+#ifndef SIM_MATH_H
+#define SIM_MATH_H
+
+#include <cmath>
+#include "Vec2.h"
+#include "Fixed.h"
+#include "FastMath.h"
+
+namespace SimMath {
+
+#ifdef PGK_DETERMINISTIC_SIM
+    typedef Fixed Scalar;           ///< Typ liczbowy stanu symulacji
+    typedef FixedWide WideScalar;   ///< Iloczyn dwóch wartości Scalar
+    const bool DETERMINISTIC = true;
+
+    inline Scalar toScalar(float value) { return Fixed::fromFloat(value); }
+    inline float toFloat(Scalar value) { return value.toFloat(); }
+    inline WideScalar mulWide(Scalar a, Scalar b) { return Fixed::mulWide(a, b); }
+    inline Scalar ratio(WideScalar num, WideScalar den) { return Fixed::ratio(num, den); }
+    inline Scalar length(Scalar x, Scalar y) { return Fixed::length(x, y); }
+    inline float atan2(Scalar y, Scalar x) { return Fixed::atan2(y, x).toFloat(); }
+
+    inline float sin(float angle) { return Fixed::sin(Fixed::fromFloat(angle)).toFloat(); }
+    inline float cos(float angle) { return Fixed::cos(Fixed::fromFloat(angle)).toFloat(); }
+    inline void sincos(float angle, float& s, float& c) {
+        Fixed fs, fc;
+        Fixed::sincos(Fixed::fromFloat(angle), fs, fc);
+        s = fs.toFloat();
+        c = fc.toFloat();
+    }
+    inline float atan2(float y, float x) { return atan2(Fixed::fromFloat(y), Fixed::fromFloat(x)); }
+    inline float sqrt(float value) {
+        // Kwadraty odległości przekraczają zakres Q16.16 - liczone w Q32.32
+        if (!(value > 0.0f)) return 0.0f;
+        if (value >= 1073741824.0f) return Fixed::fromRaw(INT32_MAX).toFloat();
+        return Fixed::sqrtWide(static_cast<uint64_t>(std::floor(value * 4294967296.0f + 0.5f))).toFloat();
+    }
+    inline float length(float x, float y) { return length(Fixed::fromFloat(x), Fixed::fromFloat(y)).toFloat(); }
+#else
+    typedef float Scalar;           ///< Typ liczbowy stanu symulacji
+    typedef float WideScalar;       ///< Iloczyn dwóch wartości Scalar
+    const bool DETERMINISTIC = false;
+
+    inline Scalar toScalar(float value) { return value; }
+    inline float toFloat(Scalar value) { return value; }
+    inline WideScalar mulWide(Scalar a, Scalar b) { return a * b; }
+    inline Scalar ratio(WideScalar num, WideScalar den) { return den != 0.0f ? num / den : 0.0f; }
+
+    inline float sin(float angle) { return FastMath::sin(angle); }
+    inline float cos(float angle) { return FastMath::cos(angle); }
+    inline void sincos(float angle, float& s, float& c) { FastMath::sincos(angle, s, c); }
+    inline float atan2(float y, float x) { return FastMath::atan2(y, x); }
+    inline float sqrt(float value) { return std::sqrt(value); }
+    inline float length(float x, float y) { return std::sqrt(x * x + y * y); }
+#endif
+
+    /**
+     * @brief Kwadrat długości wektora (x, y) bez przepełnienia
+     */
+    inline WideScalar lengthSquared(Scalar x, Scalar y) { return mulWide(x, x) + mulWide(y, y); }
+
+    /**
+     * @brief Długość wektora (w trybie deterministycznym bez kwadratów w float)
+     */
+    inline float length(const Vec2& v) { return length(v.x, v.y); }
+
+    /**
+     * @brief Wektor jednostkowy o zadanym kącie (jedno wywołanie sincos)
+     */
+    inline Vec2 direction(float angle) {
+        float s, c;
+        sincos(angle, s, c);
+        return Vec2(c, s);
+    }
+}
+
+#endif // SIM_MATH_H
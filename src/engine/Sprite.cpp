@@ -1,48 +1,76 @@
 #include "Sprite.h"
-#include "TextureManager.h"
+#include "Transform.h"
+#include "AnimationLibrary.h"
+#include <cmath>
+
+bool Sprite::batchActive = false;
+Mat2x3 Sprite::batchView;
+ALLEGRO_TRANSFORM Sprite::batchTransform;
+unsigned Sprite::batchViewVersion = 1;
 
 Sprite::Sprite()
-    : texture(nullptr)
+    : texture(INVALID_TEXTURE_HANDLE)
     , position(0.0f, 0.0f)
     , scale(1.0f, 1.0f)
     , rotation(0.0f)
     , alpha(1.0f)
-    , currentAnimation(nullptr)
+    , animation(INVALID_ANIMATION_HANDLE)
+    , animationListener(nullptr)
     , sourceX(0)
     , sourceY(0)
     , sourceWidth(0)
     , sourceHeight(0)
+    , localWidth(0)
+    , localHeight(0)
+    , localDirty(true)
+    , worldViewVersion(0)
 {
 }
 
 Sprite::~Sprite() {
-    // Czyszczenie animacji
-    for (auto& pair : animations) {
-        delete pair.second;
+    if (animation != INVALID_ANIMATION_HANDLE) {
+        AnimationSystem::getInstance()->destroy(animation);
     }
-    animations.clear();
+    TextureManager::getInstance()->releaseTexture(texture);
 }
 
 bool Sprite::loadTexture(const std::string& path) {
-    texture = TextureManager::getInstance()->loadTexture(path);
-    if (texture) {
-        sourceWidth = al_get_bitmap_width(texture);
-        sourceHeight = al_get_bitmap_height(texture);
-        return true;
+    TextureManager* textures = TextureManager::getInstance();
+    TextureHandle loaded = textures->acquireTexture(path);
+    if (loaded == INVALID_TEXTURE_HANDLE) {
+        return false;
     }
-    return false;
+
+    textures->releaseTexture(texture);
+    texture = loaded;
+
+    TextureAlpha textureAlpha;
+    ALLEGRO_BITMAP* bitmap = textures->resolve(texture, textureAlpha);
+    sourceWidth = al_get_bitmap_width(bitmap);
+    sourceHeight = al_get_bitmap_height(bitmap);
+    return true;
 }
 
+// Setery oznaczają macierz do przeliczenia tylko przy faktycznej zmianie -
+// encje ustawiają pozycję sprite'a w każdej klatce, także gdy stoją w miejscu
 void Sprite::setPosition(float x, float y) {
+    if (x == position.getX() && y == position.getY()) return;
     position.setPosition(x, y);
+    localDirty = true;
+    updateAnimationBounds();
 }
 
 void Sprite::setRotation(float angle) {
+    if (angle == rotation) return;
     rotation = angle;
+    localDirty = true;
 }
 
 void Sprite::setScale(float scaleX, float scaleY) {
+    if (scaleX == scale.getX() && scaleY == scale.getY()) return;
     scale.setPosition(scaleX, scaleY);
+    localDirty = true;
+    updateAnimationBounds();
 }
 
 void Sprite::setAlpha(float newAlpha) {
@@ -57,76 +85,66 @@ void Sprite::setSourceRect(int x, int y, int width, int height) {
 }
 
 void Sprite::resetSourceRect() {
-    if (texture) {
+    TextureAlpha textureAlpha;
+    ALLEGRO_BITMAP* bitmap = TextureManager::getInstance()->resolve(texture, textureAlpha, false);
+    if (bitmap) {
         sourceX = sourceY = 0;
-        sourceWidth = al_get_bitmap_width(texture);
-        sourceHeight = al_get_bitmap_height(texture);
+        sourceWidth = al_get_bitmap_width(bitmap);
+        sourceHeight = al_get_bitmap_height(bitmap);
     }
 }
 
-void Sprite::addAnimation(Animation* animation) {
-    if (animation) {
-        // Jeli animacja o tej nazwie ju istnieje, usu j
-        auto it = animations.find(animation->getName());
-        if (it != animations.end()) {
-            delete it->second;
-        }
+void Sprite::playAnimation(StringId name) {
+    playClip(AnimationLibrary::getInstance()->find(name));
+}
 
-        animations[animation->getName()] = animation;
+void Sprite::playAnimation(const std::string& name) {
+    playClip(AnimationLibrary::getInstance()->find(name));
+}
 
-        // Jeli to pierwsza animacja, ustaw j jako aktualn
-        if (!currentAnimation) {
-            currentAnimation = animation;
-        }
+void Sprite::playClip(AnimationClipId clip) {
+    if (!AnimationLibrary::getInstance()->get(clip)) return;
+
+    if (animation == INVALID_ANIMATION_HANDLE) {
+        animation = AnimationSystem::getInstance()->create();
+        AnimationSystem::getInstance()->setListener(animation, animationListener);
     }
+    AnimationSystem::getInstance()->play(animation, clip);
+    updateAnimationBounds();
 }
 
-void Sprite::playAnimation(const std::string& name) {
-    auto it = animations.find(name);
-    if (it != animations.end()) {
-        if (currentAnimation != it->second) {
-            if (currentAnimation) {
-                currentAnimation->stop();
-            }
-            currentAnimation = it->second;
-        }
-        currentAnimation->play();
-    }
+// Położenie i rozmiar dla poziomu szczegółowości animacji (AnimationSystem)
+void Sprite::updateAnimationBounds() {
+    if (animation == INVALID_ANIMATION_HANDLE) return;
+
+    float scaleX = std::fabs(scale.getX());
+    float scaleY = std::fabs(scale.getY());
+    AnimationSystem::getInstance()->setBounds(animation, position.toVec2(), scaleX > scaleY ? scaleX : scaleY);
+}
+
+void Sprite::setAnimationListener(AnimationEventListener* listener) {
+    animationListener = listener;
+    AnimationSystem::getInstance()->setListener(animation, listener);
 }
 
 void Sprite::stopAnimation() {
-    if (currentAnimation) {
-        currentAnimation->stop();
-    }
+    AnimationSystem::getInstance()->stop(animation);
 }
 
 void Sprite::pauseAnimation() {
-    if (currentAnimation) {
-        currentAnimation->pause();
-    }
+    AnimationSystem::getInstance()->pause(animation);
 }
 
 void Sprite::resumeAnimation() {
-    if (currentAnimation) {
-        currentAnimation->play();
-    }
+    AnimationSystem::getInstance()->resume(animation);
 }
 
-void Sprite::updateAnimation(float deltaTime) {
-    if (currentAnimation) {
-        currentAnimation->update(deltaTime);
-
-        // Aktualizacja rdowego prostokta na podstawie aktualnej klatki
-        const AnimationFrame& frame = currentAnimation->getCurrentFrame();
-        sourceX = frame.x;
-        sourceY = frame.y;
-        sourceWidth = frame.width;
-        sourceHeight = frame.height;
-    }
+AnimationState Sprite::getAnimationState() const {
+    return AnimationSystem::getInstance()->getState(animation);
 }
 
-Animation* Sprite::getCurrentAnimation() const {
-    return currentAnimation;
+const AnimationClip* Sprite::getCurrentClip() const {
+    return AnimationLibrary::getInstance()->get(getAnimationState().clip);
 }
 
 Point2D Sprite::getPosition() const {
@@ -145,43 +163,96 @@ float Sprite::getAlpha() const {
     return alpha;
 }
 
+AnimationSourceRect Sprite::getSourceRect() const {
+    if (animation != INVALID_ANIMATION_HANDLE) {
+        if (const AnimationSourceRect* rect = AnimationSystem::getInstance()->getSourceRect(animation)) {
+            return *rect;
+        }
+    }
+    return AnimationSourceRect{ sourceX, sourceY, sourceWidth, sourceHeight, 0, 0, sourceWidth, sourceHeight };
+}
+
 int Sprite::getWidth() const {
-    return sourceWidth;
+    return getSourceRect().cellWidth;
 }
 
 int Sprite::getHeight() const {
-    return sourceHeight;
+    return getSourceRect().cellHeight;
 }
 
 void Sprite::draw() {
-    if (!texture) return;
+    // Tekstura zwolniona przez unloadTexture jest wczytywana w tle - do tego
+    // czasu sprite nie jest rysowany (zastępcza nie pasuje do klatek arkusza)
+    TextureAlpha textureAlpha;
+    ALLEGRO_BITMAP* bitmap = TextureManager::getInstance()->resolve(texture, textureAlpha, false);
+    if (!bitmap) return;
+
+    // Klatka animacji zapisana przez AnimationSystem::update
+    AnimationSourceRect source = getSourceRect();
 
-    // Zachowanie obecnego stanu transformacji
-    ALLEGRO_TRANSFORM transform;
-    al_copy_transform(&transform, al_get_current_transform());
+    // Klatka przycięta do pustego obszaru - nie ma czego rysować
+    if (source.width <= 0 || source.height <= 0) return;
+
+    // Macierz sprite'a: środek pełnej komórki -> skala -> obrót -> pozycja; zależy od
+    // rozmiaru komórki, więc jego zmiana (inny klip, setSourceRect) też ją unieważnia
+    if (localDirty || source.cellWidth != localWidth || source.cellHeight != localHeight) {
+        localMatrix = Mat2x3::fromTRS(position.toVec2(), rotation, scale.toVec2(),
+            Vec2(source.cellWidth / 2.0f, source.cellHeight / 2.0f));
+        localWidth = source.cellWidth;
+        localHeight = source.cellHeight;
+        localDirty = false;
+        worldViewVersion = 0;
+    }
 
-    // Ustawienie nowej transformacji dla sprite'a
-    ALLEGRO_TRANSFORM spriteTransform;
-    al_identity_transform(&spriteTransform);
-    al_translate_transform(&spriteTransform, -sourceWidth / 2.0f, -sourceHeight / 2.0f);
-    al_scale_transform(&spriteTransform, scale.getX(), scale.getY());
-    al_rotate_transform(&spriteTransform, rotation);
-    al_translate_transform(&spriteTransform, position.getX(), position.getY());
-    al_compose_transform(&spriteTransform, &transform);
+    ALLEGRO_TRANSFORM previous;
+    const ALLEGRO_TRANSFORM* restore = &batchTransform;
+    if (batchActive) {
+        // W partii widok jest znany - złożenie tylko gdy zmienił się widok lub sprite
+        if (worldViewVersion != batchViewVersion) {
+            Transform::toAllegro(batchView * localMatrix, worldTransform);
+            worldViewVersion = batchViewVersion;
+        }
+    }
+    else {
+        // Poza partią złożenie z bieżącą transformacją Allegro
+        al_copy_transform(&previous, al_get_current_transform());
+        Transform::toAllegro(Transform::fromAllegro(previous) * localMatrix, worldTransform);
+        worldViewVersion = 0;
+        restore = &previous;
+    }
 
-    // Zastosowanie transformacji
-    al_use_transform(&spriteTransform);
+    al_use_transform(&worldTransform);
 
-    // Rysowanie z uwzgldnieniem przezroczystoci i aktualnej klatki animacji
+    // Rysowanie z uwzględnieniem przezroczystości i aktualnej klatki animacji -
+    // klatka przycięta trafia w swoje miejsce w pełnej komórce
+    TextureBlendScope blend(textureAlpha, alpha);
     al_draw_tinted_bitmap_region(
-        texture,
+        bitmap,
         al_map_rgba_f(1.0f, 1.0f, 1.0f, alpha),
-        sourceX, sourceY,
-        sourceWidth, sourceHeight,
-        0, 0,
+        source.x, source.y,
+        source.width, source.height,
+        source.offsetX, source.offsetY,
         0
     );
 
-    // Przywrcenie poprzedniej transformacji
-    al_use_transform(&transform);
+    // Przywrócenie poprzedniej transformacji (widoku partii)
+    al_use_transform(restore);
+}
+
+void Sprite::beginBatch(const Mat2x3& view) {
+    const Mat2x3& last = batchView;
+    if (view.a != last.a || view.b != last.b || view.c != last.c || view.d != last.d ||
+        view.tx != last.tx || view.ty != last.ty) {
+        batchView = view;
+        // Wersja 0 oznacza nieaktualne złożenie, więc jest pomijana
+        batchViewVersion = batchViewVersion + 1 == 0 ? 1 : batchViewVersion + 1;
+    }
+
+    Transform::toAllegro(batchView, batchTransform);
+    al_use_transform(&batchTransform);
+    batchActive = true;
+}
+
+void Sprite::endBatch() {
+    batchActive = false;
 }
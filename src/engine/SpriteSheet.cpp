@@ -0,0 +1,586 @@
+﻿#include "SpriteSheet.h"
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+// Klatki są kopiowane do pliku bajt po bajcie i czytane z odwzorowania bez konwersji
+static_assert(std::is_trivially_copyable<AnimationFrame>::value, "AnimationFrame must be trivially copyable");
+static_assert(sizeof(AnimationFrame) % sizeof(float) == 0, "AnimationFrame must keep 4-byte alignment");
+static_assert(std::is_trivially_copyable<AnimationClipEvent>::value, "AnimationClipEvent must be trivially copyable");
+
+namespace {
+
+    // Klip w trakcie kompilacji
+    struct CookClip {
+        std::string name;
+        bool looping;
+        std::vector<AnimationFrame> frames;
+        std::vector<AnimationClipEvent> events;
+        std::vector<int> eventLines;  // Wiersze zdarzeń (komunikaty błędów)
+        std::vector<bool> eventAtEnd; // Zdarzenie na końcu klipu
+    };
+
+    // Wyrównanie przesunięcia do 4 bajtów (tablice int/float w odwzorowaniu)
+    uint32_t align4(size_t offset) {
+        return static_cast<uint32_t>((offset + 3) & ~static_cast<size_t>(3));
+    }
+
+    template <typename T>
+    void writeAt(std::vector<unsigned char>& buffer, uint32_t offset, const T* values, size_t count) {
+        if (count > 0) {
+            std::memcpy(buffer.data() + offset, values, sizeof(T) * count);
+        }
+    }
+
+    // Statystyki przycinania zapisywane w nagłówku
+    struct TrimStats {
+        uint32_t cellPixels = 0;
+        uint32_t trimmedPixels = 0;
+        uint32_t sourceBytes = 0;
+        uint32_t atlasBytes = 0;
+    };
+
+    // Prostokąt przyciętej klatki w teksturze źródłowej i w atlasie
+    struct PackRect {
+        int x, y, width, height;
+        int packedX, packedY;
+    };
+
+    const int ATLAS_PADDING = 1;  // Odstęp między klatkami atlasu (filtrowanie liniowe)
+
+    // Zawęża prostokąt do pikseli o alfie większej od progu (pusty: szerokość 0)
+    void trimRect(const ALLEGRO_LOCKED_REGION* region, int bitmapWidth, int bitmapHeight,
+        int threshold, int& x, int& y, int& width, int& height) {
+        int left = std::max(x, 0);
+        int top = std::max(y, 0);
+        int right = std::min(x + width, bitmapWidth);
+        int bottom = std::min(y + height, bitmapHeight);
+
+        int minX = right, minY = bottom, maxX = left - 1, maxY = top - 1;
+        for (int py = top; py < bottom; py++) {
+            // ABGR_8888_LE: bajty R, G, B, A
+            const unsigned char* row = static_cast<const unsigned char*>(region->data) + py * region->pitch;
+            for (int px = left; px < right; px++) {
+                if (row[px * 4 + 3] > threshold) {
+                    minX = std::min(minX, px);
+                    maxX = std::max(maxX, px);
+                    minY = std::min(minY, py);
+                    maxY = py;
+                }
+            }
+        }
+
+        if (maxX < minX) {
+            width = height = 0;
+            return;
+        }
+        x = minX;
+        y = minY;
+        width = maxX - minX + 1;
+        height = maxY - minY + 1;
+    }
+
+    // Pakowanie półkowe: klatki od najwyższej, wiersz po wierszu
+    void packShelves(std::vector<PackRect*>& order, int& atlasWidth, int& atlasHeight) {
+        long long area = 0;
+        int widest = 0;
+        for (const PackRect* rect : order) {
+            area += static_cast<long long>(rect->width + ATLAS_PADDING) * (rect->height + ATLAS_PADDING);
+            widest = std::max(widest, rect->width);
+        }
+        std::sort(order.begin(), order.end(), [](const PackRect* a, const PackRect* b) {
+            return a->height != b->height ? a->height > b->height : a->width > b->width;
+        });
+
+        atlasWidth = std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))));
+        int x = 0, y = 0, shelfHeight = 0;
+        for (PackRect* rect : order) {
+            if (x > 0 && x + rect->width > atlasWidth) {
+                y += shelfHeight + ATLAS_PADDING;
+                x = 0;
+                shelfHeight = 0;
+            }
+            rect->packedX = x;
+            rect->packedY = y;
+            x += rect->width + ATLAS_PADDING;
+            shelfHeight = std::max(shelfHeight, rect->height);
+        }
+        atlasHeight = std::max(y + shelfHeight, 1);
+        atlasWidth = std::max(atlasWidth, 1);
+    }
+
+    // Przycina klatki wszystkich klipów i zapisuje atlas z przyciętymi klatkami
+    bool trimAndPack(const std::string& texturePath, const std::string& atlasPath, int threshold,
+        std::vector<CookClip>& cookClips, TrimStats& stats, std::string& error) {
+        ALLEGRO_STATE state;
+        al_store_state(&state, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS | ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+        al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+        al_set_new_bitmap_format(ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE);
+
+        // Bez premnożenia alfy - piksele trafiają do pliku atlasu bez zmian
+        ALLEGRO_BITMAP* source = al_load_bitmap_flags(texturePath.c_str(), ALLEGRO_NO_PREMULTIPLIED_ALPHA);
+        if (!source) {
+            al_restore_state(&state);
+            error = "Cannot load sprite sheet texture for trimming: " + texturePath;
+            return false;
+        }
+        int sourceWidth = al_get_bitmap_width(source);
+        int sourceHeight = al_get_bitmap_height(source);
+        stats.sourceBytes = static_cast<uint32_t>(sourceWidth * sourceHeight * 4);
+
+        ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(source, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+        if (!region) {
+            al_destroy_bitmap(source);
+            al_restore_state(&state);
+            error = "Cannot lock sprite sheet texture: " + texturePath;
+            return false;
+        }
+
+        // Ta sama komórka użyta w kilku klipach jest przycinana i pakowana raz
+        std::map<std::tuple<int, int, int, int>, size_t> unique;
+        std::vector<PackRect> rects;
+        std::vector<size_t> frameRects;
+        for (CookClip& clip : cookClips) {
+            for (AnimationFrame& frame : clip.frames) {
+                stats.cellPixels += static_cast<uint32_t>(frame.cellWidth * frame.cellHeight);
+
+                auto key = std::make_tuple(frame.x, frame.y, frame.width, frame.height);
+                auto it = unique.find(key);
+                if (it == unique.end()) {
+                    PackRect rect = { frame.x, frame.y, frame.width, frame.height, 0, 0 };
+                    trimRect(region, sourceWidth, sourceHeight, threshold, rect.x, rect.y, rect.width, rect.height);
+                    it = unique.emplace(key, rects.size()).first;
+                    rects.push_back(rect);
+                }
+                frameRects.push_back(it->second);
+            }
+        }
+        al_unlock_bitmap(source);
+
+        std::vector<PackRect*> packed;
+        for (PackRect& rect : rects) {
+            if (rect.width > 0) packed.push_back(&rect);
+        }
+        int atlasWidth, atlasHeight;
+        packShelves(packed, atlasWidth, atlasHeight);
+
+        // Kopiowanie pikseli 1:1 (bez mieszania) do przezroczystego atlasu
+        ALLEGRO_BITMAP* atlas = al_create_bitmap(atlasWidth, atlasHeight);
+        bool saved = false;
+        if (atlas) {
+            al_set_target_bitmap(atlas);
+            al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+            al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+            for (const PackRect* rect : packed) {
+                al_draw_bitmap_region(source, rect->x, rect->y, rect->width, rect->height, rect->packedX, rect->packedY, 0);
+            }
+            saved = al_save_bitmap(atlasPath.c_str(), atlas);
+            stats.atlasBytes = static_cast<uint32_t>(atlasWidth * atlasHeight * 4);
+            al_destroy_bitmap(atlas);
+        }
+        al_destroy_bitmap(source);
+        al_restore_state(&state);
+
+        if (!saved) {
+            error = "Cannot write trimmed atlas: " + atlasPath;
+            return false;
+        }
+
+        // Klatki wskazują atlas; przesunięcie liczone względem pełnej komórki
+        size_t next = 0;
+        for (CookClip& clip : cookClips) {
+            for (AnimationFrame& frame : clip.frames) {
+                const PackRect& rect = rects[frameRects[next++]];
+                stats.trimmedPixels += static_cast<uint32_t>(rect.width * rect.height);
+                if (rect.width == 0) {
+                    frame.x = frame.y = frame.width = frame.height = 0;
+                    continue;
+                }
+                frame.offsetX += rect.x - frame.x;
+                frame.offsetY += rect.y - frame.y;
+                frame.x = rect.packedX;
+                frame.y = rect.packedY;
+                frame.width = rect.width;
+                frame.height = rect.height;
+            }
+        }
+        return true;
+    }
+
+    // Czas modyfikacji pliku (0 jeśli plik nie istnieje)
+    time_t modificationTime(const std::string& path) {
+        ALLEGRO_FS_ENTRY* entry = al_create_fs_entry(path.c_str());
+        if (!entry) return 0;
+        time_t mtime = al_fs_entry_exists(entry) ? al_get_fs_entry_mtime(entry) : 0;
+        al_destroy_fs_entry(entry);
+        return mtime;
+    }
+
+    // Tekstura źródłowa i włączenie przycinania z opisu (bez pełnej kompilacji)
+    bool readTextureSource(const std::string& descriptorPath, std::string& texturePath, bool& trimmed) {
+        std::ifstream in(descriptorPath);
+        if (!in) return false;
+
+        trimmed = false;
+        std::string line;
+        while (std::getline(in, line)) {
+            size_t comment = line.find('#');
+            if (comment != std::string::npos) {
+                line.erase(comment);
+            }
+
+            std::istringstream words(line);
+            std::string command;
+            if (!(words >> command)) continue;
+            if (command == "texture") {
+                words >> texturePath;
+            }
+            else if (command == "trim") {
+                trimmed = true;
+            }
+        }
+        return !texturePath.empty();
+    }
+
+} // namespace
+
+SpriteSheet::SpriteSheet()
+    : header(nullptr)
+    , clips(nullptr)
+    , frames(nullptr)
+    , frameEnds(nullptr)
+    , events(nullptr)
+    , strings(nullptr)
+{
+}
+
+bool SpriteSheet::cook(const std::string& descriptorPath, const std::string& cookedPath, std::string& error) {
+    std::ifstream in(descriptorPath);
+    if (!in) {
+        error = "Cannot open sprite sheet descriptor: " + descriptorPath;
+        return false;
+    }
+
+    std::string texturePath;
+    int trimThreshold = -1;
+    int cellWidth = 0;
+    int cellHeight = 0;
+    std::vector<CookClip> cookClips;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream words(line);
+        std::string command;
+        if (!(words >> command)) continue;
+
+        std::string where = descriptorPath + ":" + std::to_string(lineNumber) + ": ";
+        if (command == "texture") {
+            if (!(words >> texturePath)) {
+                error = where + "texture path expected";
+                return false;
+            }
+        }
+        else if (command == "cell") {
+            if (!(words >> cellWidth >> cellHeight) || cellWidth <= 0 || cellHeight <= 0) {
+                error = where + "cell <width> <height> expected";
+                return false;
+            }
+        }
+        else if (command == "clip") {
+            CookClip clip;
+            std::string mode = "loop";
+            if (!(words >> clip.name)) {
+                error = where + "clip name expected";
+                return false;
+            }
+            words >> mode;
+            if (mode != "loop" && mode != "once") {
+                error = where + "clip mode must be loop or once";
+                return false;
+            }
+            clip.looping = mode == "loop";
+            cookClips.push_back(clip);
+        }
+        else if (command == "rows") {
+            int firstRow, rows, columns;
+            float duration;
+            if (!(words >> firstRow >> rows >> columns >> duration) || rows <= 0 || columns <= 0) {
+                error = where + "rows <first> <count> <columns> <duration> expected";
+                return false;
+            }
+            if (cookClips.empty() || cellWidth <= 0) {
+                error = where + "rows requires a preceding clip and cell";
+                return false;
+            }
+            for (int row = firstRow; row < firstRow + rows; row++) {
+                for (int col = 0; col < columns; col++) {
+                    cookClips.back().frames.emplace_back(col * cellWidth, row * cellHeight, cellWidth, cellHeight, duration);
+                }
+            }
+        }
+        else if (command == "frame") {
+            int x, y, width, height;
+            int offsetX = 0;
+            int offsetY = 0;
+            float duration;
+            if (!(words >> x >> y >> width >> height >> duration)) {
+                error = where + "frame <x> <y> <width> <height> <duration> expected";
+                return false;
+            }
+            words >> offsetX >> offsetY;
+            if (cookClips.empty()) {
+                error = where + "frame requires a preceding clip";
+                return false;
+            }
+            cookClips.back().frames.emplace_back(x, y, width, height, duration, offsetX, offsetY);
+        }
+        else if (command == "trim") {
+            if (!(words >> trimThreshold) || trimThreshold < 0 || trimThreshold > 254) {
+                error = where + "trim <alpha threshold 0-254> expected";
+                return false;
+            }
+        }
+        else if (command == "event") {
+            std::string name;
+            std::string frame;
+            if (!(words >> name >> frame)) {
+                error = where + "event <name> <frame|end> expected";
+                return false;
+            }
+            if (cookClips.empty()) {
+                error = where + "event requires a preceding clip";
+                return false;
+            }
+
+            // Numer klatki końca jest znany dopiero po wszystkich klatkach klipu
+            CookClip& clip = cookClips.back();
+            AnimationClipEvent event = { hashString(name.data(), name.size()), 0 };
+            bool atEnd = frame == "end";
+            if (!atEnd) {
+                std::istringstream number(frame);
+                int index;
+                if (!(number >> index) || index < 0) {
+                    error = where + "event frame must be a frame index or end";
+                    return false;
+                }
+                event.frame = static_cast<uint32_t>(index);
+            }
+            clip.events.push_back(event);
+            clip.eventLines.push_back(lineNumber);
+            clip.eventAtEnd.push_back(atEnd);
+        }
+        else {
+            error = where + "unknown command '" + command + "'";
+            return false;
+        }
+    }
+
+    if (texturePath.empty()) {
+        error = descriptorPath + ": missing texture";
+        return false;
+    }
+    for (CookClip& clip : cookClips) {
+        if (clip.frames.empty() || clip.frames.size() > 256) {
+            error = descriptorPath + ": clip '" + clip.name + "' must have 1-256 frames";
+            return false;
+        }
+        for (size_t e = 0; e < clip.events.size(); e++) {
+            if (clip.eventAtEnd[e]) {
+                clip.events[e].frame = static_cast<uint32_t>(clip.frames.size());
+            }
+            else if (clip.events[e].frame >= clip.frames.size()) {
+                error = descriptorPath + ":" + std::to_string(clip.eventLines[e]) + ": event frame out of range";
+                return false;
+            }
+        }
+    }
+
+    TrimStats trimStats;
+    if (trimThreshold >= 0) {
+        std::string atlasPath = getAtlasPath(descriptorPath);
+        if (!trimAndPack(texturePath, atlasPath, trimThreshold, cookClips, trimStats, error)) {
+            return false;
+        }
+        texturePath = atlasPath;
+    }
+    else {
+        for (const CookClip& clip : cookClips) {
+            for (const AnimationFrame& frame : clip.frames) {
+                trimStats.cellPixels += static_cast<uint32_t>(frame.cellWidth * frame.cellHeight);
+            }
+        }
+        trimStats.trimmedPixels = trimStats.cellPixels;
+    }
+
+    // Blok napisów: ścieżka tekstury, potem nazwy klipów
+    std::string stringBlock = texturePath + '\0';
+    std::vector<SpriteSheetFileClip> fileClips;
+    std::vector<AnimationFrame> fileFrames;
+    std::vector<float> fileEnds;
+    std::vector<AnimationClipEvent> fileEvents;
+    for (const CookClip& clip : cookClips) {
+        SpriteSheetFileClip entry;
+        entry.name = static_cast<uint32_t>(stringBlock.size());
+        entry.firstFrame = static_cast<uint32_t>(fileFrames.size());
+        entry.frameCount = static_cast<uint32_t>(clip.frames.size());
+        entry.firstEvent = static_cast<uint32_t>(fileEvents.size());
+        entry.eventCount = static_cast<uint32_t>(clip.events.size());
+        entry.looping = clip.looping ? 1 : 0;
+        fileClips.push_back(entry);
+        stringBlock += clip.name + '\0';
+        fileEvents.insert(fileEvents.end(), clip.events.begin(), clip.events.end());
+
+        float total = 0.0f;
+        for (const AnimationFrame& frame : clip.frames) {
+            fileFrames.push_back(frame);
+            total += frame.duration;
+            fileEnds.push_back(total);
+        }
+    }
+
+    SpriteSheetFileHeader fileHeader;
+    fileHeader.magic = FILE_MAGIC;
+    fileHeader.version = FILE_VERSION;
+    fileHeader.frameStride = sizeof(AnimationFrame);
+    fileHeader.clipCount = static_cast<uint32_t>(fileClips.size());
+    fileHeader.frameCount = static_cast<uint32_t>(fileFrames.size());
+    fileHeader.eventCount = static_cast<uint32_t>(fileEvents.size());
+    fileHeader.texturePath = 0;
+    fileHeader.clipsOffset = align4(sizeof(SpriteSheetFileHeader));
+    fileHeader.framesOffset = align4(fileHeader.clipsOffset + sizeof(SpriteSheetFileClip) * fileClips.size());
+    fileHeader.endsOffset = align4(fileHeader.framesOffset + sizeof(AnimationFrame) * fileFrames.size());
+    fileHeader.eventsOffset = align4(fileHeader.endsOffset + sizeof(float) * fileEnds.size());
+    fileHeader.stringsOffset = align4(fileHeader.eventsOffset + sizeof(AnimationClipEvent) * fileEvents.size());
+    fileHeader.stringsSize = static_cast<uint32_t>(stringBlock.size());
+    fileHeader.fileSize = fileHeader.stringsOffset + fileHeader.stringsSize;
+    fileHeader.cellPixels = trimStats.cellPixels;
+    fileHeader.trimmedPixels = trimStats.trimmedPixels;
+    fileHeader.sourceBytes = trimStats.sourceBytes;
+    fileHeader.atlasBytes = trimStats.atlasBytes;
+
+    std::vector<unsigned char> buffer(fileHeader.fileSize, 0);
+    writeAt(buffer, 0, &fileHeader, 1);
+    writeAt(buffer, fileHeader.clipsOffset, fileClips.data(), fileClips.size());
+    writeAt(buffer, fileHeader.framesOffset, fileFrames.data(), fileFrames.size());
+    writeAt(buffer, fileHeader.endsOffset, fileEnds.data(), fileEnds.size());
+    writeAt(buffer, fileHeader.eventsOffset, fileEvents.data(), fileEvents.size());
+    writeAt(buffer, fileHeader.stringsOffset, stringBlock.data(), stringBlock.size());
+
+    std::ofstream out(cookedPath, std::ios::binary | std::ios::trunc);
+    if (!out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size())) {
+        error = "Cannot write cooked sprite sheet: " + cookedPath;
+        return false;
+    }
+    return true;
+}
+
+bool SpriteSheet::needsCooking(const std::string& descriptorPath, const std::string& cookedPath) {
+    time_t descriptorTime = modificationTime(descriptorPath);
+    if (descriptorTime == 0) {
+        // Sam plik binarny (np. w wydaniu gry) jest używany bez sprawdzania
+        return false;
+    }
+    time_t cookedTime = modificationTime(cookedPath);
+    if (cookedTime < descriptorTime) {
+        return true;
+    }
+
+    // Przycięty arkusz zależy też od tekstury źródłowej i wygenerowanego atlasu
+    std::string texturePath;
+    bool trimmed = false;
+    if (!readTextureSource(descriptorPath, texturePath, trimmed) || !trimmed) {
+        return false;
+    }
+    return modificationTime(texturePath) > cookedTime || modificationTime(getAtlasPath(descriptorPath)) == 0;
+}
+
+bool SpriteSheet::open(const std::string& cookedPath, std::string& error) {
+    header = nullptr;
+    if (!file.open(cookedPath)) {
+        error = "Cannot map cooked sprite sheet: " + cookedPath;
+        return false;
+    }
+    if (file.getSize() < sizeof(SpriteSheetFileHeader)) {
+        error = "Cooked sprite sheet too small: " + cookedPath;
+        file.close();
+        return false;
+    }
+
+    const unsigned char* base = file.getData();
+    header = reinterpret_cast<const SpriteSheetFileHeader*>(base);
+    if (!validate(error)) {
+        error = cookedPath + ": " + error;
+        header = nullptr;
+        file.close();
+        return false;
+    }
+
+    clips = reinterpret_cast<const SpriteSheetFileClip*>(base + header->clipsOffset);
+    frames = reinterpret_cast<const AnimationFrame*>(base + header->framesOffset);
+    frameEnds = reinterpret_cast<const float*>(base + header->endsOffset);
+    events = reinterpret_cast<const AnimationClipEvent*>(base + header->eventsOffset);
+    strings = reinterpret_cast<const char*>(base + header->stringsOffset);
+    return true;
+}
+
+bool SpriteSheet::validate(std::string& error) const {
+    if (header->magic != FILE_MAGIC || header->version != FILE_VERSION ||
+        header->frameStride != sizeof(AnimationFrame)) {
+        error = "unsupported sprite sheet format";
+        return false;
+    }
+
+    // Wszystkie tablice muszą leżeć w pliku - plik jest czytany bez kopiowania
+    uint64_t size = file.getSize();
+    if (header->fileSize != size ||
+        header->clipsOffset + uint64_t(sizeof(SpriteSheetFileClip)) * header->clipCount > size ||
+        header->framesOffset + uint64_t(sizeof(AnimationFrame)) * header->frameCount > size ||
+        header->endsOffset + uint64_t(sizeof(float)) * header->frameCount > size ||
+        header->eventsOffset + uint64_t(sizeof(AnimationClipEvent)) * header->eventCount > size ||
+        header->stringsOffset + uint64_t(header->stringsSize) > size ||
+        header->stringsSize == 0 || (header->clipsOffset | header->framesOffset | header->endsOffset | header->eventsOffset) % 4 != 0) {
+        error = "corrupted sprite sheet layout";
+        return false;
+    }
+
+    const unsigned char* base = file.getData();
+    const char* block = reinterpret_cast<const char*>(base + header->stringsOffset);
+    if (block[header->stringsSize - 1] != '\0' || header->texturePath >= header->stringsSize) {
+        error = "corrupted sprite sheet strings";
+        return false;
+    }
+
+    const SpriteSheetFileClip* fileClips = reinterpret_cast<const SpriteSheetFileClip*>(base + header->clipsOffset);
+    for (uint32_t i = 0; i < header->clipCount; i++) {
+        const SpriteSheetFileClip& clip = fileClips[i];
+        if (clip.name >= header->stringsSize || clip.frameCount == 0 || clip.frameCount > 256 ||
+            uint64_t(clip.firstFrame) + clip.frameCount > header->frameCount ||
+            uint64_t(clip.firstEvent) + clip.eventCount > header->eventCount) {
+            error = "corrupted sprite sheet clip";
+            return false;
+        }
+    }
+    return true;
+}
+
+AnimationClip SpriteSheet::getClip(int index) const {
+    const SpriteSheetFileClip& clip = clips[index];
+    return AnimationClip(getClipName(index), frames + clip.firstFrame, frameEnds + clip.firstFrame,
+        static_cast<int>(clip.frameCount), clip.looping != 0,
+        events + clip.firstEvent, static_cast<int>(clip.eventCount));
+}
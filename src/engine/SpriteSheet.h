@@ -0,0 +1,154 @@
+﻿/**
+ * @file SpriteSheet.h
+ * @brief Opis arkusza sprite'ów (tekstura, klatki, klipy) wczytywany z pliku
+ *
+ * Arkusz jest opisywany w pliku tekstowym (.sheet), np.:
+ * @code
+ * texture assets/textures/enemy_idle.png
+ * cell 180 150
+ * clip enemy_idle loop
+ * rows 0 4 5 0.07
+ * event footstep 5
+ * @endcode
+ * Polecenia (jedno na wiersz, # rozpoczyna komentarz):
+ * - texture <ścieżka> - tekstura arkusza,
+ * - cell <szer> <wys> - rozmiar komórki siatki dla polecenia rows,
+ * - clip <nazwa> [loop|once] - rozpoczyna klip (domyślnie zapętlony),
+ * - rows <pierwszy> <liczba> <kolumny> <czas> - klatki z wierszy siatki,
+ * - frame <x> <y> <szer> <wys> <czas> [<przesunięcieX> <przesunięcieY>] - pojedyncza klatka,
+ * - event <nazwa> <klatka|end> - zdarzenie bieżącego klipu (AnimationClipEvent),
+ * - trim <próg alfa> - przycinanie przezroczystych brzegów klatek (0-254).
+ *
+ * Przy przycinaniu kompilacja wczytuje teksturę, zawęża każdą klatkę do
+ * pikseli o alfie większej od progu (zapisując przesunięcie w komórce)
+ * i pakuje przycięte klatki do nowego, mniejszego atlasu
+ * (<ścieżka opisu>.png), który staje się teksturą arkusza. Sprite rysuje
+ * wtedy tylko przycięty prostokąt.
+ *
+ * Plik tekstowy jest kompilowany do pliku binarnego (<ścieżka>.bin),
+ * w którym klatki (AnimationFrame) i sumy prefiksowe czasów leżą w tablicach
+ * gotowych do użycia. Przy starcie plik binarny jest tylko mapowany
+ * w pamięci, a klipy (AnimationClip) wskazują jego tablice bezpośrednio.
+ * Kompilacja jest powtarzana, gdy plik tekstowy jest nowszy.
+ */
+
+#ifndef SPRITE_SHEET_H
+#define SPRITE_SHEET_H
+
+#include <cstdint>
+#include <string>
+#include "Animation.h"
+#include "MappedFile.h"
+
+ /**
+  * @brief Nagłówek skompilowanego arkusza
+  *
+  * Przesunięcia są liczone od początku pliku, a nazwy od początku bloku napisów.
+  */
+struct SpriteSheetFileHeader {
+    uint32_t magic;          ///< SpriteSheet::FILE_MAGIC
+    uint32_t version;        ///< SpriteSheet::FILE_VERSION
+    uint32_t frameStride;    ///< sizeof(AnimationFrame) przy kompilacji
+    uint32_t clipCount;      ///< Liczba klipów
+    uint32_t frameCount;     ///< Liczba klatek wszystkich klipów
+    uint32_t eventCount;     ///< Liczba zdarzeń wszystkich klipów
+    uint32_t texturePath;    ///< Ścieżka tekstury (przesunięcie w bloku napisów)
+    uint32_t clipsOffset;    ///< Tablica SpriteSheetFileClip
+    uint32_t framesOffset;   ///< Tablica AnimationFrame
+    uint32_t endsOffset;     ///< Tablica sum prefiksowych (float, osobno dla każdego klipu)
+    uint32_t eventsOffset;   ///< Tablica AnimationClipEvent
+    uint32_t stringsOffset;  ///< Blok napisów zakończonych zerem
+    uint32_t stringsSize;    ///< Rozmiar bloku napisów
+    uint32_t fileSize;       ///< Rozmiar całego pliku
+    uint32_t cellPixels;     ///< Suma pól pełnych komórek wszystkich klatek
+    uint32_t trimmedPixels;  ///< Suma pól klatek po przycięciu
+    uint32_t sourceBytes;    ///< Rozmiar tekstury źródłowej (RGBA, bajty)
+    uint32_t atlasBytes;     ///< Rozmiar tekstury arkusza (RGBA, bajty)
+};
+
+/**
+ * @brief Klip w skompilowanym arkuszu
+ */
+struct SpriteSheetFileClip {
+    uint32_t name;           ///< Nazwa (przesunięcie w bloku napisów)
+    uint32_t firstFrame;     ///< Indeks pierwszej klatki klipu
+    uint32_t frameCount;     ///< Liczba klatek klipu
+    uint32_t firstEvent;     ///< Indeks pierwszego zdarzenia klipu
+    uint32_t eventCount;     ///< Liczba zdarzeń klipu
+    uint32_t looping;        ///< 1 dla klipu zapętlonego
+};
+
+/**
+ * @brief Zmapowany, skompilowany arkusz sprite'ów
+ */
+class SpriteSheet {
+private:
+    MappedFile file;                       ///< Odwzorowanie pliku binarnego
+    const SpriteSheetFileHeader* header;   ///< Nagłówek (w odwzorowaniu)
+    const SpriteSheetFileClip* clips;      ///< Klipy (w odwzorowaniu)
+    const AnimationFrame* frames;          ///< Klatki (w odwzorowaniu)
+    const float* frameEnds;                ///< Sumy prefiksowe (w odwzorowaniu)
+    const AnimationClipEvent* events;      ///< Zdarzenia (w odwzorowaniu)
+    const char* strings;                   ///< Blok napisów (w odwzorowaniu)
+
+    bool validate(std::string& error) const;
+
+    // Zablokowanie kopiowania (wskaźniki do odwzorowania)
+    SpriteSheet(const SpriteSheet&) = delete;
+    SpriteSheet& operator=(const SpriteSheet&) = delete;
+
+public:
+    static const uint32_t FILE_MAGIC = 0x534B4750;  ///< "PGKS" w little-endian
+    static const uint32_t FILE_VERSION = 3;         ///< Wersja układu pliku
+
+    SpriteSheet();
+
+    /**
+     * @brief Kompiluje opis tekstowy do pliku binarnego
+     * @param descriptorPath Ścieżka pliku .sheet
+     * @param cookedPath Ścieżka pliku wynikowego
+     * @param[out] error Opis błędu (plik:wiersz: komunikat)
+     * @return true jeśli plik binarny został zapisany
+     */
+    static bool cook(const std::string& descriptorPath, const std::string& cookedPath, std::string& error);
+
+    /**
+     * @brief Sprawdza, czy plik binarny trzeba (ponownie) skompilować
+     * @return true jeśli opis tekstowy istnieje, a plik binarny nie istnieje lub jest starszy
+     *         (dla arkusza z przycinaniem także od tekstury źródłowej) albo brakuje atlasu
+     */
+    static bool needsCooking(const std::string& descriptorPath, const std::string& cookedPath);
+
+    static std::string getCookedPath(const std::string& descriptorPath) { return descriptorPath + ".bin"; }
+    static std::string getAtlasPath(const std::string& descriptorPath) { return descriptorPath + ".png"; }
+
+    /**
+     * @brief Mapuje i sprawdza skompilowany arkusz
+     * @param cookedPath Ścieżka pliku binarnego
+     * @param[out] error Opis błędu
+     * @return true jeśli plik jest poprawny
+     */
+    bool open(const std::string& cookedPath, std::string& error);
+
+    const char* getTexturePath() const { return strings + header->texturePath; }
+    int getClipCount() const { return static_cast<int>(header->clipCount); }
+    int getFrameCount() const { return static_cast<int>(header->frameCount); }
+    const AnimationFrame* getFrames() const { return frames; }
+    const char* getClipName(int index) const { return strings + clips[index].name; }
+
+    // Statystyki przycinania (bez przycinania liczby pikseli są równe, a rozmiary tekstur zerowe)
+    uint32_t getCellPixels() const { return header->cellPixels; }
+    uint32_t getTrimmedPixels() const { return header->trimmedPixels; }
+    uint32_t getSourceBytes() const { return header->sourceBytes; }
+    uint32_t getAtlasBytes() const { return header->atlasBytes; }
+
+    /**
+     * @brief Tworzy klip wskazujący tablice arkusza (bez kopiowania klatek)
+     * @param index Indeks klipu w arkuszu
+     *
+     * Klip jest ważny, dopóki arkusz jest otwarty.
+     */
+    AnimationClip getClip(int index) const;
+};
+
+#endif // SPRITE_SHEET_H
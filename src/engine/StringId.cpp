@@ -0,0 +1,37 @@
+﻿#include "StringId.h"
+
+StringTable* StringTable::instance = nullptr;
+
+StringTable* StringTable::getInstance() {
+    if (!instance) {
+        instance = new StringTable();
+    }
+    return instance;
+}
+
+void StringTable::releaseInstance() {
+    if (instance) {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+StringId StringTable::intern(const std::string& str) {
+    StringId id = hashString(str.data(), str.size());
+    auto it = strings.find(id);
+    if (it == strings.end()) {
+        strings.emplace(id, str);
+    }
+    else if (it->second != str) {
+        // Dwa różne napisy o tym samym skrócie byłyby nierozróżnialne
+        collisionCount++;
+        logger.error("StringId collision: \"" + str + "\" and \"" + it->second + "\"");
+    }
+    return id;
+}
+
+const std::string& StringTable::lookup(StringId id) const {
+    static const std::string empty;
+    auto it = strings.find(id);
+    return it != strings.end() ? it->second : empty;
+}
@@ -0,0 +1,93 @@
+﻿/**
+ * @file StringId.h
+ * @brief Internowane identyfikatory napisów (32-bitowy skrót FNV-1a)
+ *
+ * Nazwy animacji, ścieżki tekstur i znaczniki obiektów są zamieniane na
+ * 32-bitowe identyfikatory, więc porównanie i wyszukiwanie w gorących
+ * ścieżkach to operacje na liczbach całkowitych. Identyfikator jest
+ * skrótem napisu, dlatego literał "nazwa"_sid liczony w czasie kompilacji
+ * (także jako etykieta case) jest równy wynikowi StringTable::intern("nazwa").
+ * StringTable przechowuje napisy do odczytu wstecznego (logi) i wykrywa
+ * kolizje skrótów.
+ */
+
+#ifndef STRING_ID_H
+#define STRING_ID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include "Logger.h"
+
+ /**
+  * @brief Identyfikator internowanego napisu
+  */
+typedef uint32_t StringId;
+
+/**
+ * @brief Identyfikator pustego napisu
+ */
+const StringId EMPTY_STRING_ID = 2166136261u;
+
+/**
+ * @brief Skrót FNV-1a napisu (dostępny w czasie kompilacji)
+ * @param str Napis
+ * @param length Długość napisu
+ * @return Identyfikator napisu
+ */
+constexpr StringId hashString(const char* str, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(str[i]);
+        // Mnożenie w 64 bitach - bez ostrzeżeń o przepełnieniu stałej
+        hash = static_cast<uint32_t>(static_cast<uint64_t>(hash) * 16777619u);
+    }
+    return hash;
+}
+
+/**
+ * @brief Literał identyfikatora, np. "Enemy"_sid
+ */
+constexpr StringId operator"" _sid(const char* str, size_t length) {
+    return hashString(str, length);
+}
+
+/**
+ * @brief Tablica internowanych napisów (Singleton)
+ */
+class StringTable {
+private:
+    static StringTable* instance;            ///< Instancja Singletona
+    std::map<StringId, std::string> strings; ///< Identyfikator -> napis
+    unsigned collisionCount;                 ///< Liczba wykrytych kolizji skrótów
+    Logger logger;                           ///< Logger do zgłaszania kolizji
+
+    StringTable() : collisionCount(0) {}
+
+    // Zablokowanie kopiowania (Singleton)
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+public:
+    static StringTable* getInstance();
+    static void releaseInstance();
+
+    /**
+     * @brief Internuje napis
+     * @param str Napis
+     * @return Identyfikator napisu (równy hashString(str))
+     */
+    StringId intern(const std::string& str);
+
+    /**
+     * @brief Odczytuje napis dla identyfikatora
+     * @param id Identyfikator
+     * @return Napis lub pusty napis, jeśli identyfikator nie był internowany
+     */
+    const std::string& lookup(StringId id) const;
+
+    unsigned getCollisionCount() const { return collisionCount; }
+};
+
+#endif // STRING_ID_H
@@ -0,0 +1,153 @@
+﻿#include "TextCache.h"
+#include <cstring>
+
+namespace {
+    // Dekoduje kolejny znak UTF-8 i przesuwa indeks
+    int decodeUtf8(const std::string& text, size_t& i) {
+        unsigned char c = static_cast<unsigned char>(text[i++]);
+        if (c < 0x80) return c;
+
+        int extra = (c >= 0xF0) ? 3 : (c >= 0xE0) ? 2 : (c >= 0xC0) ? 1 : 0;
+        int codepoint = c & (0x3F >> extra);
+        for (int k = 0; k < extra && i < text.size(); k++) {
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i++]) & 0x3F);
+        }
+        return codepoint;
+    }
+}
+
+TextRunCache::TextRunCache(size_t capacity)
+    : font(nullptr)
+    , lineHeight(0)
+    , capacity(capacity)
+    , frame(0)
+{
+    std::memset(asciiAdvance, -1, sizeof(asciiAdvance));
+}
+
+TextRunCache::~TextRunCache() {
+    clear();
+}
+
+void TextRunCache::setFont(ALLEGRO_FONT* newFont) {
+    clear();
+    font = newFont;
+    lineHeight = font ? al_get_font_line_height(font) : 0;
+    std::memset(asciiAdvance, -1, sizeof(asciiAdvance));
+    glyphAdvance.clear();
+}
+
+int TextRunCache::getGlyphAdvance(int codepoint, int nextCodepoint) {
+    // Szerokość z kerningiem względem następnego znaku (ALLEGRO_NO_KERNING dla ostatniego)
+    if (codepoint >= 0 && codepoint < 128 && nextCodepoint < 128) {
+        int column = nextCodepoint < 0 ? 128 : nextCodepoint;
+        if (asciiAdvance[codepoint][column] < 0) {
+            asciiAdvance[codepoint][column] = static_cast<int16_t>(al_get_glyph_advance(font, codepoint, nextCodepoint));
+        }
+        return asciiAdvance[codepoint][column];
+    }
+
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(codepoint)) << 32) | static_cast<uint32_t>(nextCodepoint);
+    auto it = glyphAdvance.find(key);
+    if (it != glyphAdvance.end()) {
+        return it->second;
+    }
+    int advance = al_get_glyph_advance(font, codepoint, nextCodepoint);
+    glyphAdvance[key] = advance;
+    return advance;
+}
+
+int TextRunCache::measure(const std::string& text) {
+    if (!font || text.empty()) return 0;
+
+    int width = 0;
+    size_t i = 0;
+    int codepoint = decodeUtf8(text, i);
+    while (true) {
+        int next = i < text.size() ? decodeUtf8(text, i) : ALLEGRO_NO_KERNING;
+        width += getGlyphAdvance(codepoint, next);
+        if (next == ALLEGRO_NO_KERNING) break;
+        codepoint = next;
+    }
+    return width;
+}
+
+std::string TextRunCache::makeKey(const std::string& text, ALLEGRO_COLOR color) {
+    unsigned char r, g, b, a;
+    al_unmap_rgba(color, &r, &g, &b, &a);
+
+    // Kolor zapisany w 4 pierwszych bajtach klucza
+    std::string key;
+    key.reserve(text.size() + 4);
+    key.push_back(static_cast<char>(r));
+    key.push_back(static_cast<char>(g));
+    key.push_back(static_cast<char>(b));
+    key.push_back(static_cast<char>(a));
+    key += text;
+    return key;
+}
+
+void TextRunCache::evictLeastRecentlyUsed() {
+    auto oldest = runs.end();
+    for (auto it = runs.begin(); it != runs.end(); ++it) {
+        if (oldest == runs.end() || it->second.lastUsedFrame < oldest->second.lastUsedFrame) {
+            oldest = it;
+        }
+    }
+    if (oldest != runs.end()) {
+        al_destroy_bitmap(oldest->second.bitmap);
+        runs.erase(oldest);
+    }
+}
+
+void TextRunCache::draw(const std::string& text, ALLEGRO_COLOR color, float x, float y, int flags) {
+    if (!font || text.empty()) return;
+
+    std::string key = makeKey(text, color);
+    auto it = runs.find(key);
+
+    if (it == runs.end()) {
+        if (runs.size() >= capacity) {
+            evictLeastRecentlyUsed();
+        }
+
+        TextRun run;
+        run.width = measure(text);
+        run.height = lineHeight;
+        run.bitmap = al_create_bitmap(run.width > 0 ? run.width : 1, run.height > 0 ? run.height : 1);
+        if (!run.bitmap) {
+            // Brak pamięci na bitmapę - rysujemy tekst bezpośrednio
+            al_draw_text(font, color, x, y, flags, text.c_str());
+            return;
+        }
+
+        // Jednorazowa rasteryzacja ciągu
+        ALLEGRO_BITMAP* prevTarget = al_get_target_bitmap();
+        al_set_target_bitmap(run.bitmap);
+        al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+        al_draw_text(font, color, 0, 0, ALLEGRO_ALIGN_LEFT, text.c_str());
+        al_set_target_bitmap(prevTarget);
+
+        it = runs.emplace(key, run).first;
+    }
+
+    TextRun& run = it->second;
+    run.lastUsedFrame = frame;
+
+    float drawX = x;
+    if (flags & ALLEGRO_ALIGN_CENTER) {
+        drawX -= run.width / 2.0f;
+    }
+    else if (flags & ALLEGRO_ALIGN_RIGHT) {
+        drawX -= run.width;
+    }
+
+    al_draw_bitmap(run.bitmap, static_cast<float>(static_cast<int>(drawX)), y, 0);
+}
+
+void TextRunCache::clear() {
+    for (auto& pair : runs) {
+        al_destroy_bitmap(pair.second.bitmap);
+    }
+    runs.clear();
+}
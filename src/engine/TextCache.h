@@ -0,0 +1,119 @@
+﻿/**
+ * @file TextCache.h
+ * @brief Bufor glifów i gotowych ciągów tekstu dla czcionek Allegro
+ *
+ * TextRunCache zapamiętuje szerokości glifów (aby mierzyć tekst bez
+ * odpytywania czcionki) oraz wyrenderowane ciągi tekstu w postaci bitmap.
+ * Dzięki temu ten sam napis nie jest układany i rasteryzowany co klatkę.
+ */
+
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+ /**
+  * @brief Bufor glifów i ciągów tekstu
+  *
+  * Glify są buforowane jako szerokości (advance) par sąsiednich znaków
+  * pobierane raz z czcionki - z kerningiem, tak jak rysuje al_draw_text.
+  * Ciągi tekstu (para napis + kolor) są rasteryzowane do osobnych bitmap
+  * i usuwane według zasady LRU po przekroczeniu pojemności bufora.
+  */
+class TextRunCache {
+private:
+    /**
+     * @brief Pojedynczy wyrenderowany ciąg tekstu
+     */
+    struct TextRun {
+        ALLEGRO_BITMAP* bitmap;   ///< Bitmapa z wyrenderowanym tekstem
+        int width;                ///< Szerokość ciągu w pikselach
+        int height;               ///< Wysokość ciągu w pikselach
+        uint64_t lastUsedFrame;   ///< Numer klatki ostatniego użycia (LRU)
+    };
+
+    ALLEGRO_FONT* font;                                  ///< Czcionka używana do renderowania
+    int lineHeight;                                      ///< Wysokość linii czcionki
+    int16_t asciiAdvance[128][129];                      ///< Szerokości par glifów ASCII (kolumna 128 - ostatni glif, -1 = nieznana)
+    std::unordered_map<uint64_t, int> glyphAdvance;      ///< Szerokości pozostałych par glifów
+    std::unordered_map<std::string, TextRun> runs;       ///< Wyrenderowane ciągi (klucz: kolor + tekst)
+    size_t capacity;                                     ///< Maksymalna liczba buforowanych ciągów
+    uint64_t frame;                                      ///< Licznik klatek dla LRU
+
+    int getGlyphAdvance(int codepoint, int nextCodepoint);
+    static std::string makeKey(const std::string& text, ALLEGRO_COLOR color);
+    void evictLeastRecentlyUsed();
+
+    // Zablokowanie kopiowania (bufor posiada bitmapy)
+    TextRunCache(const TextRunCache&) = delete;
+    TextRunCache& operator=(const TextRunCache&) = delete;
+
+public:
+    /**
+     * @brief Konstruktor
+     * @param capacity Maksymalna liczba buforowanych ciągów tekstu
+     */
+    explicit TextRunCache(size_t capacity = 64);
+
+    /**
+     * @brief Destruktor - zwalnia bitmapy wszystkich ciągów
+     */
+    ~TextRunCache();
+
+    /**
+     * @brief Ustawia czcionkę i czyści bufor
+     * @param newFont Czcionka Allegro
+     */
+    void setFont(ALLEGRO_FONT* newFont);
+
+    /**
+     * @brief Pobiera czcionkę bufora
+     * @return Wskaźnik na czcionkę
+     */
+    ALLEGRO_FONT* getFont() const { return font; }
+
+    /**
+     * @brief Pobiera wysokość linii tekstu
+     * @return Wysokość w pikselach
+     */
+    int getLineHeight() const { return lineHeight; }
+
+    /**
+     * @brief Mierzy szerokość tekstu na podstawie buforowanych glifów
+     * @param text Tekst w UTF-8
+     * @return Szerokość w pikselach (z kerningiem, jak przy rysowaniu)
+     */
+    int measure(const std::string& text);
+
+    /**
+     * @brief Rysuje tekst z bufora ciągów (renderuje go przy pierwszym użyciu)
+     * @param text Tekst do narysowania
+     * @param color Kolor tekstu
+     * @param x Pozycja X punktu zaczepienia
+     * @param y Pozycja Y (górna krawędź)
+     * @param flags Wyrównanie (ALLEGRO_ALIGN_LEFT/CENTER/RIGHT)
+     */
+    void draw(const std::string& text, ALLEGRO_COLOR color, float x, float y, int flags);
+
+    /**
+     * @brief Oznacza początek nowej klatki (dla polityki LRU)
+     */
+    void beginFrame() { frame++; }
+
+    /**
+     * @brief Usuwa wszystkie buforowane ciągi
+     */
+    void clear();
+
+    /**
+     * @brief Pobiera liczbę buforowanych ciągów
+     * @return Liczba ciągów w buforze
+     */
+    size_t getRunCount() const { return runs.size(); }
+};
+
+#endif // TEXT_CACHE_H
@@ -0,0 +1,66 @@
+﻿#include "TextureAlpha.h"
+
+long TextureBlendScope::drawCounts[3] = { 0, 0, 0 };
+
+TextureAlpha analyzeTextureAlpha(ALLEGRO_BITMAP* bitmap) {
+    if (!bitmap) return TextureAlpha::TRANSLUCENT;
+
+    // Format z alfą w stałym bajcie (ostatnim) niezależnie od formatu bitmapy
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    if (!region) return TextureAlpha::TRANSLUCENT;
+
+    int width = al_get_bitmap_width(bitmap);
+    int height = al_get_bitmap_height(bitmap);
+    TextureAlpha result = TextureAlpha::SOLID;
+    for (int y = 0; y < height && result != TextureAlpha::TRANSLUCENT; y++) {
+        const unsigned char* row = static_cast<const unsigned char*>(region->data) + y * region->pitch;
+        for (int x = 0; x < width; x++) {
+            unsigned char alpha = row[x * 4 + 3];
+            if (alpha == 255) continue;
+            if (alpha != 0) {
+                // Jeden półprzezroczysty piksel rozstrzyga - dalsze skanowanie zbędne
+                result = TextureAlpha::TRANSLUCENT;
+                break;
+            }
+            result = TextureAlpha::BINARY;
+        }
+    }
+
+    al_unlock_bitmap(bitmap);
+    return result;
+}
+
+TextureBlendScope::TextureBlendScope(TextureAlpha alpha, float tint)
+    : mode(tint < 1.0f ? TextureAlpha::TRANSLUCENT : alpha)
+{
+    drawCounts[static_cast<int>(mode)]++;
+    if (mode == TextureAlpha::TRANSLUCENT) return;
+
+    al_get_separate_blender(&previousOp, &previousSource, &previousDestination,
+        &previousAlphaOp, &previousAlphaSource, &previousAlphaDestination);
+
+    // Kopiowanie bez odczytu celu; przy alfie binarnej piksele o alfie 0 odrzuca test
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    if (mode == TextureAlpha::BINARY) {
+        al_set_render_state(ALLEGRO_ALPHA_FUNCTION, ALLEGRO_RENDER_GREATER);
+        al_set_render_state(ALLEGRO_ALPHA_TEST_VALUE, 0);
+        al_set_render_state(ALLEGRO_ALPHA_TEST, 1);
+    }
+}
+
+TextureBlendScope::~TextureBlendScope() {
+    if (mode == TextureAlpha::TRANSLUCENT) return;
+
+    if (mode == TextureAlpha::BINARY) {
+        al_set_render_state(ALLEGRO_ALPHA_TEST, 0);
+    }
+    al_set_separate_blender(previousOp, previousSource, previousDestination,
+        previousAlphaOp, previousAlphaSource, previousAlphaDestination);
+}
+
+long TextureBlendScope::takeDrawCount(TextureAlpha alpha) {
+    long& count = drawCounts[static_cast<int>(alpha)];
+    long value = count;
+    count = 0;
+    return value;
+}
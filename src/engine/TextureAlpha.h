@@ -0,0 +1,76 @@
+﻿/**
+ * @file TextureAlpha.h
+ * @brief Klasyfikacja przezroczystości tekstur i dobór stanu mieszania
+ *
+ * Tekstura jest przy ładowaniu skanowana raz i zaliczana do jednej z klas:
+ * - SOLID - wszystkie piksele nieprzezroczyste (podłoga, ściany),
+ * - BINARY - alfa wyłącznie 0 lub 255 (wycięte kształty),
+ * - TRANSLUCENT - półprzezroczyste piksele (wygładzone krawędzie, efekty).
+ * Tekstury nieprzezroczyste rysowane są bez mieszania, a tekstury z alfą
+ * binarną z testem alfy zamiast mieszania - karta graficzna nie musi
+ * odczytywać bufora docelowego.
+ */
+
+#ifndef TEXTURE_ALPHA_H
+#define TEXTURE_ALPHA_H
+
+#include <allegro5/allegro.h>
+
+ /**
+  * @brief Klasa przezroczystości tekstury
+  */
+enum class TextureAlpha {
+    SOLID,        ///< Brak przezroczystości - rysowanie bez mieszania
+    BINARY,       ///< Piksele całkowicie przezroczyste lub nieprzezroczyste - test alfy
+    TRANSLUCENT   ///< Piksele półprzezroczyste - zwykłe mieszanie alfa
+};
+
+/**
+ * @brief Wyznacza klasę przezroczystości bitmapy
+ * @param bitmap Bitmapa do przeskanowania (najlepiej pamięciowa - blokada jest tania)
+ * @return Klasa przezroczystości (TRANSLUCENT gdy bitmapy nie da się zablokować)
+ */
+TextureAlpha analyzeTextureAlpha(ALLEGRO_BITMAP* bitmap);
+
+/**
+ * @brief Ustawia stan mieszania odpowiedni dla klasy tekstury na czas zakresu
+ *
+ * Szybka ścieżka jest wybierana tylko dla rysowania bez przezroczystości
+ * całego obiektu (tint < 1 wymaga mieszania). Poprzedni blender jest
+ * przywracany w destruktorze, a test alfy wyłączany.
+ *
+ * Przykład: { TextureBlendScope blend(alpha); al_draw_bitmap(...); }
+ */
+class TextureBlendScope {
+private:
+    TextureAlpha mode;          ///< Użyty sposób rysowania
+    int previousOp;             ///< Poprzednia operacja mieszania koloru
+    int previousSource;         ///< Poprzedni współczynnik źródła koloru
+    int previousDestination;    ///< Poprzedni współczynnik celu koloru
+    int previousAlphaOp;        ///< Poprzednia operacja mieszania alfy
+    int previousAlphaSource;    ///< Poprzedni współczynnik źródła alfy
+    int previousAlphaDestination; ///< Poprzedni współczynnik celu alfy
+
+    static long drawCounts[3];  ///< Liczba rysowań każdą ścieżką od ostatniego odczytu
+
+    TextureBlendScope(const TextureBlendScope&) = delete;
+    TextureBlendScope& operator=(const TextureBlendScope&) = delete;
+
+public:
+    /**
+     * @brief Ustawia stan mieszania
+     * @param alpha Klasa przezroczystości rysowanej tekstury
+     * @param tint Przezroczystość całego obiektu (1 - brak)
+     */
+    explicit TextureBlendScope(TextureAlpha alpha, float tint = 1.0f);
+    ~TextureBlendScope();
+
+    /**
+     * @brief Pobiera i zeruje liczbę rysowań daną ścieżką
+     * @param alpha Ścieżka rysowania
+     * @return Liczba rysowań od poprzedniego wywołania
+     */
+    static long takeDrawCount(TextureAlpha alpha);
+};
+
+#endif // TEXTURE_ALPHA_H
@@ -1,18 +1,51 @@
 // TextureManager.cpp
 #include "TextureManager.h"
+#include "AnimationLibrary.h"
 #include <allegro5/allegro_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 
 TextureManager* TextureManager::instance = nullptr;
 
-TextureManager::TextureManager() {
-    // Inicjalizacja dodatku do obsugi obrazw
+namespace {
+    const char* ALPHA_NAMES[] = { "opaque", "binary alpha", "translucent" };
+    const int PLACEHOLDER_SIZE = 16;
+    const size_t INITIAL_HANDLE_SLOTS = 64;
+}
+
+TextureManager::TextureManager()
+    : alphaCounts{ 0, 0, 0 }
+    , stopping(false)
+    , loadingCount(0)
+    , uploadBudgetMs(2.0)
+    , uploadsThisFrame(0)
+    , placeholder(nullptr)
+    , memoryBudget(256u * 1024u * 1024u)
+    , residentBytes(0)
+    , frame(0)
+    , evictionsThisFrame(0)
+    , reloads(0)
+{
+    HandleSlot empty = { 0, INVALID_TEXTURE_HANDLE };
+    slots.assign(INITIAL_HANDLE_SLOTS, empty);
+
+    // Inicjalizacja dodatku do obsługi obrazów
     if (!al_init_image_addon()) {
         logger.error("Failed to initialize image addon!");
     }
 }
 
 TextureManager::~TextureManager() {
+    stopWorkers();
     unloadAllTextures();
+    if (placeholder) {
+        al_destroy_bitmap(placeholder);
+    }
+    for (auto& pair : sheets) {
+        delete pair.second.sheet;
+    }
+    sheets.clear();
 }
 
 TextureManager* TextureManager::getInstance() {
@@ -29,56 +62,524 @@ void TextureManager::releaseInstance() {
     }
 }
 
-ALLEGRO_BITMAP* TextureManager::loadTexture(const std::string& path) {
-    // Sprawd czy tekstura ju jest zaadowana
-    if (isTextureLoaded(path)) {
-        return textures[path];
+TextureHandle TextureManager::findHandle(StringId hash, std::string_view path) const {
+    // Zapełnienie do połowy gwarantuje pustą komórkę kończącą próbkowanie
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        const HandleSlot& slot = slots[i];
+        if (slot.handle == INVALID_TEXTURE_HANDLE) {
+            return INVALID_TEXTURE_HANDLE;
+        }
+        // Porównanie ścieżek tylko przy zgodnym skrócie
+        if (slot.hash == hash && (path.empty() || entries[slot.handle].path == path)) {
+            return slot.handle;
+        }
     }
+}
 
-    // Zaaduj now tekstur
-    ALLEGRO_BITMAP* texture = al_load_bitmap(path.c_str());
+void TextureManager::insertHandle(StringId hash, TextureHandle handle) {
+    if (entries.size() * 2 > slots.size()) {
+        // Przebudowa do dwukrotnie większej tablicy - skróty są zapamiętane
+        std::vector<HandleSlot> old;
+        old.swap(slots);
+        HandleSlot empty = { 0, INVALID_TEXTURE_HANDLE };
+        slots.assign(old.size() * 2, empty);
+        for (const HandleSlot& slot : old) {
+            if (slot.handle != INVALID_TEXTURE_HANDLE) {
+                insertHandle(slot.hash, slot.handle);
+            }
+        }
+    }
 
-    if (texture == nullptr) {
-        logger.error("Failed to load texture: " + path);
+    size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    while (slots[i].handle != INVALID_TEXTURE_HANDLE) {
+        i = (i + 1) & mask;
+    }
+    slots[i].hash = hash;
+    slots[i].handle = handle;
+}
+
+TextureHandle TextureManager::findOrCreateHandle(std::string_view path) {
+    StringId id = hashString(path.data(), path.size());
+    TextureHandle handle = findHandle(id, path);
+    if (handle != INVALID_TEXTURE_HANDLE) {
+        return handle;
+    }
+
+    // Pierwsze użycie ścieżki - rejestracja w tablicy napisów dla getTexture(StringId)
+    std::string pathString(path);
+    StringTable::getInstance()->intern(pathString);
+
+    handle = static_cast<TextureHandle>(entries.size());
+    TextureEntry entry = { nullptr, TextureAlpha::TRANSLUCENT, TextureState::UNLOADED, id, pathString, 0, 0, 0 };
+    entries.push_back(entry);
+    insertHandle(id, handle);
+    return handle;
+}
+
+ALLEGRO_BITMAP* TextureManager::loadTexture(std::string_view path) {
+    TextureAlpha alpha;
+    return loadTexture(path, alpha);
+}
+
+ALLEGRO_BITMAP* TextureManager::loadTexture(std::string_view path, TextureAlpha& alpha) {
+    TextureHandle handle = findOrCreateHandle(path);
+    loadNow(handle);
+
+    TextureEntry& entry = entries[handle];
+    entry.lastUsed = frame;
+    alpha = entry.alpha;
+    return entry.state == TextureState::READY ? entry.bitmap : nullptr;
+}
+
+void TextureManager::loadNow(TextureHandle handle) {
+    TextureEntry& entry = entries[handle];
+    switch (entry.state) {
+    case TextureState::READY:
+        break;
+    case TextureState::LOADING:
+        // Zlecona wcześniej asynchronicznie - potrzebna od razu
+        waitForTexture(handle);
+        break;
+    default: {
+        // Załaduj teksturę (po błędzie próbujemy ponownie)
+        if (entry.state == TextureState::EVICTED) {
+            reloads++;
+        }
+        TextureAlpha alpha = TextureAlpha::TRANSLUCENT;
+        ALLEGRO_BITMAP* decoded = decodeTexture(entry.path, alpha);
+        entry.state = TextureState::LOADING;
+        loadingCount++;
+        finishTexture(handle, decoded, alpha);
+        break;
+    }
+    }
+}
+
+TextureHandle TextureManager::requestTexture(std::string_view path) {
+    TextureHandle handle = findOrCreateHandle(path);
+    TextureEntry& entry = entries[handle];
+    entry.refCount++;
+    if (entry.state == TextureState::UNLOADED || entry.state == TextureState::EVICTED) {
+        queueDecode(handle);
+    }
+    return handle;
+}
+
+void TextureManager::prefetchTexture(std::string_view path) {
+    TextureHandle handle = findOrCreateHandle(path);
+    TextureEntry& entry = entries[handle];
+    if (entry.state == TextureState::UNLOADED || entry.state == TextureState::EVICTED) {
+        queueDecode(handle);
+    }
+}
+
+TextureHandle TextureManager::acquireTexture(std::string_view path) {
+    TextureHandle handle = findOrCreateHandle(path);
+    loadNow(handle);
+
+    TextureEntry& entry = entries[handle];
+    if (entry.state != TextureState::READY) {
+        return INVALID_TEXTURE_HANDLE;
+    }
+    entry.refCount++;
+    entry.lastUsed = frame;
+    return handle;
+}
+
+void TextureManager::addTextureRef(TextureHandle handle) {
+    if (handle < entries.size()) {
+        entries[handle].refCount++;
+    }
+}
+
+void TextureManager::releaseTexture(TextureHandle handle) {
+    if (handle < entries.size() && entries[handle].refCount > 0) {
+        // Czas oddania ostatniej referencji wyznacza kolejność zwalniania
+        entries[handle].refCount--;
+        entries[handle].lastUsed = frame;
+    }
+}
+
+void TextureManager::queueDecode(TextureHandle handle) {
+    TextureEntry& entry = entries[handle];
+    if (entry.state == TextureState::EVICTED) {
+        reloads++;
+    }
+    entry.state = TextureState::LOADING;
+    loadingCount++;
+
+    // Wątki uruchamiane dopiero przy pierwszym zleceniu
+    if (workers.empty()) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        unsigned count = hardware > 2 ? 2 : 1;
+        for (unsigned i = 0; i < count; i++) {
+            workers.emplace_back(&TextureManager::workerLoop, this);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        jobs.push_back(DecodeJob{ handle, entry.path });
+    }
+    jobAvailable.notify_one();
+}
+
+ALLEGRO_BITMAP* TextureManager::resolve(TextureHandle handle, TextureAlpha& alpha, bool usePlaceholder) {
+    if (handle >= entries.size()) {
         return nullptr;
     }
 
-    // Zapisz tekstur w mapie
-    textures[path] = texture;
-    logger.info("Texture loaded: " + path);
+    TextureEntry& entry = entries[handle];
+    switch (entry.state) {
+    case TextureState::READY:
+        entry.lastUsed = frame;
+        alpha = entry.alpha;
+        return entry.bitmap;
+    case TextureState::FAILED:
+        return nullptr;
+    case TextureState::UNLOADED:
+    case TextureState::EVICTED:
+        // Tekstura zwolniona - wczytanie w tle, do tego czasu zastępcza
+        queueDecode(handle);
+        break;
+    case TextureState::LOADING:
+        break;
+    }
+    if (!usePlaceholder) {
+        return nullptr;
+    }
+
+    // Szachownica w kolorze magenty - wyraźnie widać, co jeszcze się ładuje
+    if (!placeholder) {
+        ALLEGRO_STATE state;
+        al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+        placeholder = al_create_bitmap(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE);
+        if (placeholder) {
+            al_set_target_bitmap(placeholder);
+            // Blokada tylko do zapisu nie zachowuje zawartości - zapisywany jest każdy piksel
+            ALLEGRO_COLOR filled = al_map_rgb(255, 0, 255);
+            ALLEGRO_COLOR empty = al_map_rgba(0, 0, 0, 0);
+            al_lock_bitmap(placeholder, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_WRITEONLY);
+            for (int y = 0; y < PLACEHOLDER_SIZE; y++) {
+                for (int x = 0; x < PLACEHOLDER_SIZE; x++) {
+                    al_put_pixel(x, y, ((x / 4) + (y / 4)) % 2 == 0 ? filled : empty);
+                }
+            }
+            al_unlock_bitmap(placeholder);
+        }
+        al_restore_state(&state);
+    }
+    alpha = TextureAlpha::BINARY;
+    return placeholder;
+}
+
+void TextureManager::processUploads() {
+    frame++;
+    uploadsThisFrame = 0;
+    evictionsThisFrame = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (loadingCount > 0) {
+        DecodeResult result;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (results.empty()) break;
+            result = results.front();
+            results.pop_front();
+        }
+
+        finishTexture(result.handle, result.bitmap, result.alpha);
+        uploadsThisFrame++;
+
+        // Budżet sprawdzany po przeniesieniu - co najmniej jedna tekstura na klatkę
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsedMs >= uploadBudgetMs) break;
+    }
+
+    if (residentBytes > memoryBudget) {
+        evictToBudget();
+    }
+}
+
+void TextureManager::evictToBudget() {
+    std::vector<TextureHandle> candidates;
+    for (TextureHandle handle = 0; handle < entries.size(); handle++) {
+        const TextureEntry& entry = entries[handle];
+        if (entry.state == TextureState::READY && entry.refCount == 0) {
+            candidates.push_back(handle);
+        }
+    }
+
+    // Najpierw tekstury najdawniej używane
+    std::sort(candidates.begin(), candidates.end(), [this](TextureHandle a, TextureHandle b) {
+        return entries[a].lastUsed < entries[b].lastUsed;
+    });
+
+    for (TextureHandle handle : candidates) {
+        if (residentBytes <= memoryBudget) break;
+        TextureEntry& entry = entries[handle];
+        logger.info("Texture evicted: " + entry.path +
+            " (" + std::to_string(entry.bytes / 1024) + " KB)");
+        destroyTexture(entry);
+        evictionsThisFrame++;
+    }
+}
+
+void TextureManager::destroyTexture(TextureEntry& entry) {
+    al_destroy_bitmap(entry.bitmap);
+    residentBytes -= entry.bytes;
+    alphaCounts[static_cast<int>(entry.alpha)]--;
+    entry.bitmap = nullptr;
+    entry.bytes = 0;
+    entry.state = TextureState::EVICTED;
+}
+
+void TextureManager::waitForTexture(TextureHandle handle) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+
+    // Zadanie jeszcze w kolejce - szybciej zdekodować je tutaj niż czekać na wątek
+    for (auto it = jobs.begin(); it != jobs.end(); ++it) {
+        if (it->handle == handle) {
+            std::string path = it->path;
+            jobs.erase(it);
+            lock.unlock();
+
+            TextureAlpha alpha = TextureAlpha::TRANSLUCENT;
+            ALLEGRO_BITMAP* decoded = decodeTexture(path, alpha);
+            finishTexture(handle, decoded, alpha);
+            return;
+        }
+    }
+
+    // Zadanie w trakcie dekodowania lub wynik czeka na przeniesienie
+    while (true) {
+        for (auto it = results.begin(); it != results.end(); ++it) {
+            if (it->handle == handle) {
+                DecodeResult result = *it;
+                results.erase(it);
+                lock.unlock();
+                finishTexture(result.handle, result.bitmap, result.alpha);
+                return;
+            }
+        }
+        resultAvailable.wait(lock);
+    }
+}
+
+void TextureManager::workerLoop() {
+    while (true) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            jobAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        // Dekodowanie PNG i skanowanie alfy poza wątkiem głównym
+        TextureAlpha alpha = TextureAlpha::TRANSLUCENT;
+        ALLEGRO_BITMAP* decoded = decodeTexture(job.path, alpha);
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            results.push_back(DecodeResult{ job.handle, decoded, alpha });
+        }
+        resultAvailable.notify_all();
+    }
+}
+
+void TextureManager::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    for (DecodeResult& result : results) {
+        if (result.bitmap) {
+            al_destroy_bitmap(result.bitmap);
+        }
+    }
+    results.clear();
+    jobs.clear();
+}
+
+void TextureManager::finishTexture(TextureHandle handle, ALLEGRO_BITMAP* decoded, TextureAlpha alpha) {
+    TextureEntry& entry = entries[handle];
+    loadingCount--;
+    const std::string& path = entry.path;
+
+    if (!decoded) {
+        entry.state = TextureState::FAILED;
+        logger.error("Failed to load texture: " + path);
+        return;
+    }
+
+    entry.bitmap = uploadTexture(decoded, alpha);
+    entry.alpha = alpha;
+    entry.state = TextureState::READY;
+    entry.lastUsed = frame;
+    alphaCounts[static_cast<int>(alpha)]++;
+
+    // Rozmiar według formatu, w którym bitmapa faktycznie jest przechowywana
+    entry.bytes = static_cast<size_t>(al_get_bitmap_width(entry.bitmap)) * al_get_bitmap_height(entry.bitmap) *
+        al_get_pixel_size(al_get_bitmap_format(entry.bitmap));
+    residentBytes += entry.bytes;
+
+    logger.info("Texture loaded: " + path + " (" + ALPHA_NAMES[static_cast<int>(alpha)] + ", " +
+        std::to_string(entry.bytes / 1024) + " KB)");
+}
+
+ALLEGRO_BITMAP* TextureManager::decodeTexture(const std::string& path, TextureAlpha& alpha) {
+    // Parametry nowych bitmap są lokalne dla wątku
+    ALLEGRO_STATE state;
+    al_store_state(&state, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
+
+    // Dekodowanie do pamięci - skanowanie alfy nie wymaga blokowania tekstury karty
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    ALLEGRO_BITMAP* decoded = al_load_bitmap(path.c_str());
+    al_restore_state(&state);
+
+    if (decoded) {
+        alpha = analyzeTextureAlpha(decoded);
+    }
+    return decoded;
+}
+
+ALLEGRO_BITMAP* TextureManager::uploadTexture(ALLEGRO_BITMAP* decoded, TextureAlpha alpha) {
+    ALLEGRO_STATE state;
+    al_store_state(&state, ALLEGRO_STATE_NEW_BITMAP_PARAMETERS);
 
+    // Tekstura nieprzezroczysta dostaje dokładnie format ekranu (kanał alfy
+    // i tak nie jest czytany), pozostałe - preferowany przez sterownik format 32-bitowy z alfą
+    ALLEGRO_DISPLAY* display = al_get_current_display();
+    int format = ALLEGRO_PIXEL_FORMAT_ANY_32_WITH_ALPHA;
+    if (alpha == TextureAlpha::SOLID) {
+        format = display ? al_get_display_format(display) : ALLEGRO_PIXEL_FORMAT_ANY_NO_ALPHA;
+    }
+    al_set_new_bitmap_flags(ALLEGRO_VIDEO_BITMAP);
+    al_set_new_bitmap_format(format);
+    ALLEGRO_BITMAP* texture = display ? al_clone_bitmap(decoded) : nullptr;
+    al_restore_state(&state);
+
+    // Bez ekranu (lub gdy zabrakło pamięci karty) zostaje bitmapa pamięciowa
+    if (!texture) {
+        return decoded;
+    }
+    al_destroy_bitmap(decoded);
     return texture;
 }
 
-ALLEGRO_BITMAP* TextureManager::getTexture(const std::string& path) {
-    if (!isTextureLoaded(path)) {
-        return loadTexture(path);
+const SpriteSheet* TextureManager::loadSpriteSheet(const std::string& descriptorPath) {
+    StringId id = StringTable::getInstance()->intern(descriptorPath);
+
+    auto it = sheets.find(id);
+    if (it != sheets.end()) {
+        if (it->second.descriptorPath != descriptorPath) {
+            logger.error("Sprite sheet path collision: " + descriptorPath + " and " + it->second.descriptorPath);
+            return nullptr;
+        }
+        return it->second.sheet;
+    }
+
+    std::string cookedPath = SpriteSheet::getCookedPath(descriptorPath);
+    std::string error;
+    bool logTrimStats = false;
+    if (SpriteSheet::needsCooking(descriptorPath, cookedPath)) {
+        if (!SpriteSheet::cook(descriptorPath, cookedPath, error)) {
+            logger.error(error);
+            return nullptr;
+        }
+        logger.info("Sprite sheet cooked: " + cookedPath);
+        logTrimStats = true;
+    }
+
+    SpriteSheet* sheet = new SpriteSheet();
+    if (!sheet->open(cookedPath, error)) {
+        // Plik z innej wersji formatu - kompilacja od nowa, jeśli jest opis
+        std::string cookError;
+        if (!SpriteSheet::cook(descriptorPath, cookedPath, cookError) || !sheet->open(cookedPath, error)) {
+            logger.error(error);
+            delete sheet;
+            return nullptr;
+        }
+    }
+
+    // Arkusz trzyma referencję do tekstury do zwolnienia menedżera
+    if (acquireTexture(sheet->getTexturePath()) == INVALID_TEXTURE_HANDLE) {
+        delete sheet;
+        return nullptr;
+    }
+
+    // Klipy wskazują klatki w odwzorowaniu - bez kopiowania tablic
+    AnimationLibrary* library = AnimationLibrary::getInstance();
+    for (int i = 0; i < sheet->getClipCount(); i++) {
+        library->addClip(sheet->getClip(i));
     }
-    return textures[path];
+
+    sheets[id] = SheetEntry{ descriptorPath, sheet };
+    logger.info("Sprite sheet loaded: " + descriptorPath);
+
+    if (logTrimStats && sheet->getAtlasBytes() > 0) {
+        logger.info("Sprite sheet trimmed: " + std::to_string(sheet->getTrimmedPixels()) + " of " +
+            std::to_string(sheet->getCellPixels()) + " frame pixels, atlas " +
+            std::to_string(sheet->getSourceBytes() / 1024) + " KB -> " +
+            std::to_string(sheet->getAtlasBytes() / 1024) + " KB");
+    }
+    return sheet;
+}
+
+ALLEGRO_BITMAP* TextureManager::getTexture(std::string_view path) {
+    return loadTexture(path);
+}
+
+ALLEGRO_BITMAP* TextureManager::getTexture(StringId pathId) {
+    TextureHandle handle = findTexture(pathId);
+    if (handle != INVALID_TEXTURE_HANDLE) {
+        loadNow(handle);
+        TextureEntry& entry = entries[handle];
+        entry.lastUsed = frame;
+        return entry.state == TextureState::READY ? entry.bitmap : nullptr;
+    }
+
+    const std::string& path = StringTable::getInstance()->lookup(pathId);
+    return path.empty() ? nullptr : loadTexture(path);
+}
+
+bool TextureManager::isTextureLoaded(std::string_view path) const {
+    TextureHandle handle = findTexture(path);
+    return handle != INVALID_TEXTURE_HANDLE && entries[handle].state == TextureState::READY;
 }
 
-bool TextureManager::isTextureLoaded(const std::string& path) const {
-    return textures.find(path) != textures.end();
+bool TextureManager::isTextureLoaded(StringId pathId) const {
+    TextureHandle handle = findTexture(pathId);
+    return handle != INVALID_TEXTURE_HANDLE && entries[handle].state == TextureState::READY;
 }
 
-void TextureManager::unloadTexture(const std::string& path) {
-    auto it = textures.find(path);
-    if (it != textures.end()) {
-        al_destroy_bitmap(it->second);
-        textures.erase(it);
-        logger.info("Texture unloaded: " + path);
+void TextureManager::unloadTexture(std::string_view path) {
+    // Uchwyt pozostaje ważny - ponowne zlecenie wczyta teksturę od nowa
+    TextureHandle handle = findTexture(path);
+    if (handle != INVALID_TEXTURE_HANDLE && entries[handle].state == TextureState::READY) {
+        destroyTexture(entries[handle]);
+        logger.info("Texture unloaded: " + entries[handle].path);
     }
 }
 
 void TextureManager::unloadAllTextures() {
-    for (auto& pair : textures) {
-        al_destroy_bitmap(pair.second);
-        logger.info("Texture unloaded: " + pair.first);
+    for (TextureEntry& entry : entries) {
+        if (entry.state != TextureState::READY) continue;
+        destroyTexture(entry);
+        logger.info("Texture unloaded: " + entry.path);
     }
-    textures.clear();
 }
 
-bool TextureManager::getTextureDimensions(const std::string& path, int& width, int& height) {
+bool TextureManager::getTextureDimensions(std::string_view path, int& width, int& height) {
     ALLEGRO_BITMAP* texture = getTexture(path);
     if (texture == nullptr) {
         return false;
@@ -88,3 +589,32 @@ bool TextureManager::getTextureDimensions(const std::string& path, int& width, i
     height = al_get_bitmap_height(texture);
     return true;
 }
+
+void TextureManager::reportStats(EngineStats& stats) {
+    stats.setCounter("tex.solid", alphaCounts[static_cast<int>(TextureAlpha::SOLID)]);
+    stats.setCounter("tex.binary", alphaCounts[static_cast<int>(TextureAlpha::BINARY)]);
+    stats.setCounter("tex.translucent", alphaCounts[static_cast<int>(TextureAlpha::TRANSLUCENT)]);
+    stats.setCounter("tex.draw_solid", TextureBlendScope::takeDrawCount(TextureAlpha::SOLID));
+    stats.setCounter("tex.draw_alpha_test", TextureBlendScope::takeDrawCount(TextureAlpha::BINARY));
+    stats.setCounter("tex.draw_blended", TextureBlendScope::takeDrawCount(TextureAlpha::TRANSLUCENT));
+    stats.setCounter("tex.loading", loadingCount);
+    stats.setCounter("tex.uploads", uploadsThisFrame);
+    stats.setCounter("tex.resident_kb", static_cast<long>(residentBytes / 1024));
+    stats.setCounter("tex.budget_kb", static_cast<long>(memoryBudget / 1024));
+    stats.setCounter("tex.evictions", evictionsThisFrame);
+    stats.setCounter("tex.reloads", reloads);
+}
+
+std::string TextureManager::memoryReport() const {
+    std::string text;
+    char line[256];
+    for (const TextureEntry& entry : entries) {
+        if (entry.state != TextureState::READY) continue;
+        snprintf(line, sizeof(line), "%s: %zu KB, refs %d, last frame %lu\n",
+            entry.path.c_str(), entry.bytes / 1024, entry.refCount, entry.lastUsed);
+        text += line;
+    }
+    snprintf(line, sizeof(line), "total: %zu KB of %zu KB\n", residentBytes / 1024, memoryBudget / 1024);
+    text += line;
+    return text;
+}
@@ -1,4 +1,5 @@
 #include "Transform.h"
+#include "SimMath.h"
 
 void Transform::translate(Point2D& point, float dx, float dy) {
     point.setX(point.getX() + dx);
@@ -6,32 +7,49 @@ void Transform::translate(Point2D& point, float dx, float dy) {
 }
 
 void Transform::scale(Point2D& point, float sx, float sy, const Point2D& center) {
-    // Przesunicie do punktu (0,0)
-    float x = point.getX() - center.getX();
-    float y = point.getY() - center.getY();
+    apply(scaling(sx, sy, center), point);
+}
 
-    // Skalowanie
-    x *= sx;
-    y *= sy;
+void Transform::rotate(Point2D& point, float angle, const Point2D& center) {
+    apply(rotation(angle, center), point);
+}
 
-    // Przesunicie z powrotem
-    point.setX(x + center.getX());
-    point.setY(y + center.getY());
+Mat2x3 Transform::scaling(float sx, float sy, const Point2D& center) {
+    return Mat2x3::scalingAbout(sx, sy, center.toVec2());
 }
 
-void Transform::rotate(Point2D& point, float angle, const Point2D& center) {
-    // Konwersja kta na radiany
-    float radians = angle * PI / 180.0f;
+Mat2x3 Transform::rotation(float angle, const Point2D& center) {
+    // Konwersja kąta na radiany
+    float radians = angle * static_cast<float>(PI) / 180.0f;
+    float s, c;
+    SimMath::sincos(radians, s, c);
+    const Vec2 pivot = center.toVec2();
+    return Mat2x3::translation(pivot.x, pivot.y) * Mat2x3(c, s, -s, c, 0.0f, 0.0f)
+        * Mat2x3::translation(-pivot.x, -pivot.y);
+}
 
-    // Przesunicie do punktu (0,0)
-    float x = point.getX() - center.getX();
-    float y = point.getY() - center.getY();
+void Transform::apply(const Mat2x3& matrix, Point2D& point) {
+    point = matrix.apply(point.toVec2());
+}
+
+void Transform::apply(const Mat2x3& matrix, Point2D* points, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        points[i] = matrix.apply(points[i].toVec2());
+    }
+}
 
-    // Rotacja
-    float newX = x * cos(radians) - y * sin(radians);
-    float newY = x * sin(radians) + y * cos(radians);
+void Transform::toAllegro(const Mat2x3& matrix, ALLEGRO_TRANSFORM& out) {
+    al_identity_transform(&out);
+    out.m[0][0] = matrix.a;
+    out.m[0][1] = matrix.b;
+    out.m[1][0] = matrix.c;
+    out.m[1][1] = matrix.d;
+    out.m[3][0] = matrix.tx;
+    out.m[3][1] = matrix.ty;
+}
 
-    // Przesunicie z powrotem
-    point.setX(newX + center.getX());
-    point.setY(newY + center.getY());
+Mat2x3 Transform::fromAllegro(const ALLEGRO_TRANSFORM& transform) {
+    return Mat2x3(transform.m[0][0], transform.m[0][1],
+        transform.m[1][0], transform.m[1][1],
+        transform.m[3][0], transform.m[3][1]);
 }
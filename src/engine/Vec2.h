@@ -0,0 +1,105 @@
+﻿/**
+ * @file Vec2.h
+ * @brief Lekki wektor 2D (typ wartościowy) do obliczeń w pętlach
+ *
+ * Vec2 jest w całości zdefiniowany w nagłówku, więc wszystkie operacje
+ * są rozwijane w miejscu wywołania. Operacje niewymagające pierwiastka
+ * są constexpr. Point2D pozostaje klasą punktu używaną w interfejsach
+ * silnika i konwertuje się do Vec2 bez kosztów.
+ */
+
+#ifndef VEC2_H
+#define VEC2_H
+
+#include <cmath>
+
+ /**
+  * @brief Wektor 2D z operatorami arytmetycznymi
+  */
+struct Vec2 {
+    float x;   ///< Składowa X
+    float y;   ///< Składowa Y
+
+    constexpr Vec2() : x(0.0f), y(0.0f) {}
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+
+    constexpr Vec2 operator+(const Vec2& o) const { return Vec2(x + o.x, y + o.y); }
+    constexpr Vec2 operator-(const Vec2& o) const { return Vec2(x - o.x, y - o.y); }
+    constexpr Vec2 operator*(float s) const { return Vec2(x * s, y * s); }
+    constexpr Vec2 operator/(float s) const { return Vec2(x / s, y / s); }
+    constexpr Vec2 operator-() const { return Vec2(-x, -y); }
+
+    Vec2& operator+=(const Vec2& o) { x += o.x; y += o.y; return *this; }
+    Vec2& operator-=(const Vec2& o) { x -= o.x; y -= o.y; return *this; }
+    Vec2& operator*=(float s) { x *= s; y *= s; return *this; }
+    Vec2& operator/=(float s) { x /= s; y /= s; return *this; }
+
+    constexpr bool operator==(const Vec2& o) const { return x == o.x && y == o.y; }
+    constexpr bool operator!=(const Vec2& o) const { return !(*this == o); }
+
+    /**
+     * @brief Iloczyn skalarny
+     */
+    constexpr float dot(const Vec2& o) const { return x * o.x + y * o.y; }
+
+    /**
+     * @brief Iloczyn wektorowy (składowa Z) - znak określa stronę
+     */
+    constexpr float cross(const Vec2& o) const { return x * o.y - y * o.x; }
+
+    /**
+     * @brief Kwadrat długości (bez pierwiastka)
+     */
+    constexpr float lengthSquared() const { return x * x + y * y; }
+
+    /**
+     * @brief Długość wektora
+     */
+    float length() const { return std::sqrt(lengthSquared()); }
+
+    /**
+     * @brief Wektor prostopadły (obrót o 90 stopni w lewo)
+     */
+    constexpr Vec2 perpendicular() const { return Vec2(-y, x); }
+
+    /**
+     * @brief Wektor jednostkowy o tym samym kierunku
+     * @return Znormalizowany wektor lub (0,0) dla wektora zerowego
+     */
+    Vec2 normalized() const {
+        float len = length();
+        return len > 0.0f ? Vec2(x / len, y / len) : Vec2();
+    }
+};
+
+constexpr Vec2 operator*(float s, const Vec2& v) { return Vec2(v.x * s, v.y * s); }
+
+/**
+ * @brief Iloczyn skalarny dwóch wektorów
+ */
+constexpr float dot(const Vec2& a, const Vec2& b) { return a.dot(b); }
+
+/**
+ * @brief Iloczyn wektorowy dwóch wektorów (składowa Z)
+ */
+constexpr float cross(const Vec2& a, const Vec2& b) { return a.cross(b); }
+
+/**
+ * @brief Interpolacja liniowa między wektorami
+ * @param a Wektor początkowy (t = 0)
+ * @param b Wektor końcowy (t = 1)
+ * @param t Parametr interpolacji
+ */
+constexpr Vec2 lerp(const Vec2& a, const Vec2& b, float t) { return Vec2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t); }
+
+/**
+ * @brief Kwadrat odległości między punktami
+ */
+constexpr float distanceSquared(const Vec2& a, const Vec2& b) { return (b - a).lengthSquared(); }
+
+/**
+ * @brief Odległość między punktami
+ */
+inline float distance(const Vec2& a, const Vec2& b) { return (b - a).length(); }
+
+#endif // VEC2_H
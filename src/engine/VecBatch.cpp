@@ -0,0 +1,117 @@
+﻿#include "VecBatch.h"
+
+#if defined(__AVX__)
+#define VEC_BATCH_AVX 1
+#include <immintrin.h>
+#endif
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define VEC_BATCH_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace VecBatch {
+
+    void transform(const float* xs, const float* ys, float* outX, float* outY, size_t count,
+        float a, float b, float c, float d, float tx, float ty) {
+        size_t i = 0;
+
+#ifdef VEC_BATCH_AVX
+        {
+            const __m256 va = _mm256_set1_ps(a), vb = _mm256_set1_ps(b);
+            const __m256 vc = _mm256_set1_ps(c), vd = _mm256_set1_ps(d);
+            const __m256 vtx = _mm256_set1_ps(tx), vty = _mm256_set1_ps(ty);
+            for (; i + 8 <= count; i += 8) {
+                __m256 x = _mm256_loadu_ps(xs + i);
+                __m256 y = _mm256_loadu_ps(ys + i);
+                __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(va, x), _mm256_mul_ps(vc, y)), vtx);
+                __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vb, x), _mm256_mul_ps(vd, y)), vty);
+                _mm256_storeu_ps(outX + i, rx);
+                _mm256_storeu_ps(outY + i, ry);
+            }
+        }
+#endif
+#ifdef VEC_BATCH_SSE
+        {
+            const __m128 va = _mm_set1_ps(a), vb = _mm_set1_ps(b);
+            const __m128 vc = _mm_set1_ps(c), vd = _mm_set1_ps(d);
+            const __m128 vtx = _mm_set1_ps(tx), vty = _mm_set1_ps(ty);
+            for (; i + 4 <= count; i += 4) {
+                __m128 x = _mm_loadu_ps(xs + i);
+                __m128 y = _mm_loadu_ps(ys + i);
+                __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(va, x), _mm_mul_ps(vc, y)), vtx);
+                __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vb, x), _mm_mul_ps(vd, y)), vty);
+                _mm_storeu_ps(outX + i, rx);
+                _mm_storeu_ps(outY + i, ry);
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            float x = xs[i];
+            float y = ys[i];
+            outX[i] = a * x + c * y + tx;
+            outY[i] = b * x + d * y + ty;
+        }
+    }
+
+    void addScaled(float* xs, float* ys, const float* dx, const float* dy, float scale, size_t count) {
+        size_t i = 0;
+
+#ifdef VEC_BATCH_AVX
+        {
+            const __m256 vs = _mm256_set1_ps(scale);
+            for (; i + 8 <= count; i += 8) {
+                _mm256_storeu_ps(xs + i, _mm256_add_ps(_mm256_loadu_ps(xs + i), _mm256_mul_ps(_mm256_loadu_ps(dx + i), vs)));
+                _mm256_storeu_ps(ys + i, _mm256_add_ps(_mm256_loadu_ps(ys + i), _mm256_mul_ps(_mm256_loadu_ps(dy + i), vs)));
+            }
+        }
+#endif
+#ifdef VEC_BATCH_SSE
+        {
+            const __m128 vs = _mm_set1_ps(scale);
+            for (; i + 4 <= count; i += 4) {
+                _mm_storeu_ps(xs + i, _mm_add_ps(_mm_loadu_ps(xs + i), _mm_mul_ps(_mm_loadu_ps(dx + i), vs)));
+                _mm_storeu_ps(ys + i, _mm_add_ps(_mm_loadu_ps(ys + i), _mm_mul_ps(_mm_loadu_ps(dy + i), vs)));
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            xs[i] += dx[i] * scale;
+            ys[i] += dy[i] * scale;
+        }
+    }
+
+    void lengthSquared(const float* xs, const float* ys, float* out, size_t count) {
+        distanceSquared(xs, ys, 0.0f, 0.0f, out, count);
+    }
+
+    void distanceSquared(const float* xs, const float* ys, float px, float py, float* out, size_t count) {
+        size_t i = 0;
+
+#ifdef VEC_BATCH_AVX
+        {
+            const __m256 vpx = _mm256_set1_ps(px), vpy = _mm256_set1_ps(py);
+            for (; i + 8 <= count; i += 8) {
+                __m256 x = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vpx);
+                __m256 y = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vpy);
+                _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)));
+            }
+        }
+#endif
+#ifdef VEC_BATCH_SSE
+        {
+            const __m128 vpx = _mm_set1_ps(px), vpy = _mm_set1_ps(py);
+            for (; i + 4 <= count; i += 4) {
+                __m128 x = _mm_sub_ps(_mm_loadu_ps(xs + i), vpx);
+                __m128 y = _mm_sub_ps(_mm_loadu_ps(ys + i), vpy);
+                _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            float x = xs[i] - px;
+            float y = ys[i] - py;
+            out[i] = x * x + y * y;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+﻿/**
+ * @file VecBatch.h
+ * @brief Operacje wsadowe na tablicach współrzędnych (układ SoA)
+ *
+ * Funkcje przyjmują osobne tablice współrzędnych X i Y (structure of
+ * arrays), dzięki czemu jedna instrukcja wektorowa przetwarza 4 (SSE)
+ * lub 8 (AVX) punktów naraz. Ścieżka AVX jest kompilowana, gdy
+ * kompilator ma włączone AVX (/arch:AVX), SSE jest używane na x64,
+ * a pozostałe elementy przetwarza zwykła pętla.
+ */
+
+#ifndef VEC_BATCH_H
+#define VEC_BATCH_H
+
+#include <cstddef>
+
+namespace VecBatch {
+
+    /**
+     * @brief Przekształcenie afiniczne punktów
+     *
+     * out = (a * x + c * y + tx, b * x + d * y + ty). Tablice wyjściowe
+     * mogą być tymi samymi tablicami co wejściowe.
+     */
+    void transform(const float* xs, const float* ys, float* outX, float* outY, size_t count,
+        float a, float b, float c, float d, float tx, float ty);
+
+    /**
+     * @brief Dodanie przeskalowanych wektorów: xs += dx * scale, ys += dy * scale
+     *
+     * Typowe użycie: aktualizacja pozycji o prędkość * deltaTime.
+     */
+    void addScaled(float* xs, float* ys, const float* dx, const float* dy, float scale, size_t count);
+
+    /**
+     * @brief Kwadraty długości wektorów: out = x * x + y * y
+     */
+    void lengthSquared(const float* xs, const float* ys, float* out, size_t count);
+
+    /**
+     * @brief Kwadraty odległości punktów od punktu (px, py)
+     */
+    void distanceSquared(const float* xs, const float* ys, float px, float py, float* out, size_t count);
+}
+
+#endif // VEC_BATCH_H
@@ -1,6 +1,5 @@
 #include "CollisionManager.h"
 #include <algorithm>
-#include <cmath>
 
 CollisionManager* CollisionManager::instance = nullptr;
 
@@ -32,40 +31,61 @@ void CollisionManager::removeCollision(Collision* collision) {
     }
 }
 
+namespace {
+    using SimMath::Scalar;
+    using SimMath::WideScalar;
+
+    // Kwadrat odległości punktu p od odcinka ab
+    WideScalar segmentDistanceSquared(const Point2D& p, const Point2D& a, const Point2D& b) {
+        Scalar abX = b.getSimX() - a.getSimX();
+        Scalar abY = b.getSimY() - a.getSimY();
+        Scalar apX = p.getSimX() - a.getSimX();
+        Scalar apY = p.getSimY() - a.getSimY();
+
+        WideScalar projection = SimMath::mulWide(apX, abX) + SimMath::mulWide(apY, abY);
+        WideScalar lengthSquared = SimMath::lengthSquared(abX, abY);
+
+        Scalar t = Scalar();
+        if (projection >= lengthSquared) t = Scalar(1);
+        else if (projection > WideScalar()) t = SimMath::ratio(projection, lengthSquared);
+
+        return SimMath::lengthSquared(apX - abX * t, apY - abY * t);
+    }
+}
+
 bool CollisionManager::checkPointTriangle(const Point2D& p, const Point2D& a, const Point2D& b, const Point2D& c) const {
-    float d1 = sign(p, a, b);
-    float d2 = sign(p, b, c);
-    float d3 = sign(p, c, a);
+    WideScalar d1 = sign(p, a, b);
+    WideScalar d2 = sign(p, b, c);
+    WideScalar d3 = sign(p, c, a);
 
-    bool hasNeg = (d1 < 0) || (d2 < 0) || (d3 < 0);
-    bool hasPos = (d1 > 0) || (d2 > 0) || (d3 > 0);
+    bool hasNeg = (d1 < WideScalar()) || (d2 < WideScalar()) || (d3 < WideScalar());
+    bool hasPos = (d1 > WideScalar()) || (d2 > WideScalar()) || (d3 > WideScalar());
 
     return !(hasNeg && hasPos);
 }
 
-float CollisionManager::sign(const Point2D& p1, const Point2D& p2, const Point2D& p3) const {
-    return (p1.getX() - p3.getX()) * (p2.getY() - p3.getY()) -
-        (p2.getX() - p3.getX()) * (p1.getY() - p3.getY());
+WideScalar CollisionManager::sign(const Point2D& p1, const Point2D& p2, const Point2D& p3) const {
+    return SimMath::mulWide(p1.getSimX() - p3.getSimX(), p2.getSimY() - p3.getSimY()) -
+        SimMath::mulWide(p2.getSimX() - p3.getSimX(), p1.getSimY() - p3.getSimY());
 }
 
 bool CollisionManager::checkCircleCircle(const Collision* a, const Collision* b) const {
-    float dx = a->getPosition().getX() - b->getPosition().getX();
-    float dy = a->getPosition().getY() - b->getPosition().getY();
-    float distanceSquared = dx * dx + dy * dy;
-    float radiusSum = a->getRadius() + b->getRadius();
-    return distanceSquared <= radiusSum * radiusSum;
+    Scalar dx = a->getPosition().getSimX() - b->getPosition().getSimX();
+    Scalar dy = a->getPosition().getSimY() - b->getPosition().getSimY();
+    Scalar radiusSum = a->getSimRadius() + b->getSimRadius();
+    return SimMath::lengthSquared(dx, dy) <= SimMath::mulWide(radiusSum, radiusSum);
 }
 
 bool CollisionManager::checkCircleRectangle(const Collision* circle, const Collision* rect) const {
-    float circleX = circle->getPosition().getX();
-    float circleY = circle->getPosition().getY();
-    float rectX = rect->getPosition().getX();
-    float rectY = rect->getPosition().getY();
-    float rectW = rect->getWidth();
-    float rectH = rect->getHeight();
+    Scalar circleX = circle->getPosition().getSimX();
+    Scalar circleY = circle->getPosition().getSimY();
+    Scalar rectX = rect->getPosition().getSimX();
+    Scalar rectY = rect->getPosition().getSimY();
+    Scalar rectW = rect->getSimWidth();
+    Scalar rectH = rect->getSimHeight();
 
-    float testX = circleX;
-    float testY = circleY;
+    Scalar testX = circleX;
+    Scalar testY = circleY;
 
     if (circleX < rectX) testX = rectX;
     else if (circleX > rectX + rectW) testX = rectX + rectW;
@@ -73,24 +93,21 @@ bool CollisionManager::checkCircleRectangle(const Collision* circle, const Colli
     if (circleY < rectY) testY = rectY;
     else if (circleY > rectY + rectH) testY = rectY + rectH;
 
-    float distX = circleX - testX;
-    float distY = circleY - testY;
-    float distanceSquared = (distX * distX) + (distY * distY);
-
-    return distanceSquared <= (circle->getRadius() * circle->getRadius());
+    return SimMath::lengthSquared(circleX - testX, circleY - testY) <=
+        SimMath::mulWide(circle->getSimRadius(), circle->getSimRadius());
 }
 
 bool CollisionManager::checkRectangleRectangle(const Collision* a, const Collision* b) const {
-    return !(a->getPosition().getX() + a->getWidth() <= b->getPosition().getX() ||
-        b->getPosition().getX() + b->getWidth() <= a->getPosition().getX() ||
-        a->getPosition().getY() + a->getHeight() <= b->getPosition().getY() ||
-        b->getPosition().getY() + b->getHeight() <= a->getPosition().getY());
+    return !(a->getPosition().getSimX() + a->getSimWidth() <= b->getPosition().getSimX() ||
+        b->getPosition().getSimX() + b->getSimWidth() <= a->getPosition().getSimX() ||
+        a->getPosition().getSimY() + a->getSimHeight() <= b->getPosition().getSimY() ||
+        b->getPosition().getSimY() + b->getSimHeight() <= a->getPosition().getSimY());
 }
 
 bool CollisionManager::checkCircleTriangle(const Collision* circle, const Collision* triangle) const {
     const auto& points = triangle->getTrianglePoints();
     const Point2D& circleCenter = circle->getPosition();
-    float radius = circle->getRadius();
+    WideScalar radiusSquared = SimMath::mulWide(circle->getSimRadius(), circle->getSimRadius());
 
     // Check if circle center is inside triangle
     if (checkPointTriangle(circleCenter, points[0], points[1], points[2])) {
@@ -99,24 +116,7 @@ bool CollisionManager::checkCircleTriangle(const Collision* circle, const Collis
 
     // Check collision with each edge of the triangle
     for (int i = 0; i < 3; i++) {
-        const Point2D& a = points[i];
-        const Point2D& b = points[(i + 1) % 3];
-
-        float ab_x = b.getX() - a.getX();
-        float ab_y = b.getY() - a.getY();
-        float t = ((circleCenter.getX() - a.getX()) * ab_x +
-            (circleCenter.getY() - a.getY()) * ab_y) /
-            (ab_x * ab_x + ab_y * ab_y);
-        t = std::max(0.0f, std::min(1.0f, t));
-
-        Point2D closest(
-            a.getX() + t * ab_x,
-            a.getY() + t * ab_y
-        );
-
-        float dx = circleCenter.getX() - closest.getX();
-        float dy = circleCenter.getY() - closest.getY();
-        if (dx * dx + dy * dy <= radius * radius) {
+        if (segmentDistanceSquared(circleCenter, points[i], points[(i + 1) % 3]) <= radiusSquared) {
             return true;
         }
     }
@@ -127,23 +127,25 @@ bool CollisionManager::checkCircleTriangle(const Collision* circle, const Collis
 bool CollisionManager::checkTriangleRectangle(const Collision* triangle, const Collision* rectangle) const {
     const auto& points = triangle->getTrianglePoints();
     Point2D rectPos = rectangle->getPosition();
-    float rectWidth = rectangle->getWidth();
-    float rectHeight = rectangle->getHeight();
+    Scalar left = rectPos.getSimX();
+    Scalar top = rectPos.getSimY();
+    Scalar right = left + rectangle->getSimWidth();
+    Scalar bottom = top + rectangle->getSimHeight();
 
     // Check if any triangle vertex is inside rectangle
     for (const auto& p : points) {
-        if (p.getX() >= rectPos.getX() && p.getX() <= rectPos.getX() + rectWidth &&
-            p.getY() >= rectPos.getY() && p.getY() <= rectPos.getY() + rectHeight) {
+        if (p.getSimX() >= left && p.getSimX() <= right &&
+            p.getSimY() >= top && p.getSimY() <= bottom) {
             return true;
         }
     }
 
     // Check if any rectangle vertex is inside triangle
-    std::vector<Point2D> rectPoints = {
+    const Point2D rectPoints[4] = {
         rectPos,
-        Point2D(rectPos.getX() + rectWidth, rectPos.getY()),
-        Point2D(rectPos.getX() + rectWidth, rectPos.getY() + rectHeight),
-        Point2D(rectPos.getX(), rectPos.getY() + rectHeight)
+        Point2D::fromScalar(right, top),
+        Point2D::fromScalar(right, bottom),
+        Point2D::fromScalar(left, bottom)
     };
 
     for (const auto& p : rectPoints) {
@@ -156,32 +158,154 @@ bool CollisionManager::checkTriangleRectangle(const Collision* triangle, const C
     for (int i = 0; i < 3; i++) {
         const Point2D& a = points[i];
         const Point2D& b = points[(i + 1) % 3];
+        Scalar abX = b.getSimX() - a.getSimX();
+        Scalar abY = b.getSimY() - a.getSimY();
         for (int j = 0; j < 4; j++) {
             const Point2D& c = rectPoints[j];
             const Point2D& d = rectPoints[(j + 1) % 4];
+            Scalar cdX = d.getSimX() - c.getSimX();
+            Scalar cdY = d.getSimY() - c.getSimY();
+            Scalar caX = a.getSimX() - c.getSimX();
+            Scalar caY = a.getSimY() - c.getSimY();
+
+            WideScalar denominator = SimMath::mulWide(abX, cdY) - SimMath::mulWide(abY, cdX);
+            if (denominator == WideScalar()) continue;
+
+            // ua = numA / denominator, ub = numB / denominator - warunek 0 <= u <= 1 bez dzielenia
+            WideScalar numA = SimMath::mulWide(cdX, caY) - SimMath::mulWide(cdY, caX);
+            WideScalar numB = SimMath::mulWide(abX, caY) - SimMath::mulWide(abY, caX);
+            if (denominator < WideScalar()) {
+                denominator = -denominator;
+                numA = -numA;
+                numB = -numB;
+            }
 
-            float denominator = ((b.getX() - a.getX()) * (d.getY() - c.getY())) -
-                ((b.getY() - a.getY()) * (d.getX() - c.getX()));
-            if (denominator == 0) continue;
+            if (numA >= WideScalar() && numA <= denominator && numB >= WideScalar() && numB <= denominator) {
+                return true;
+            }
+        }
+    }
 
-            float ua = (((d.getX() - c.getX()) * (a.getY() - c.getY())) -
-                ((d.getY() - c.getY()) * (a.getX() - c.getX()))) / denominator;
-            float ub = (((b.getX() - a.getX()) * (a.getY() - c.getY())) -
-                ((b.getY() - a.getY()) * (a.getX() - c.getX()))) / denominator;
+    return false;
+}
 
-            if (ua >= 0 && ua <= 1 && ub >= 0 && ub <= 1) {
-                return true;
+bool CollisionManager::checkCircleConvex(const Point2D& center, Scalar radius, const Point2D* points, size_t count) const {
+    // Środek wewnątrz części (wierzchołki w orientacji dodatniej) albo krawędź bliżej niż promień
+    WideScalar radiusSquared = SimMath::mulWide(radius, radius);
+    bool inside = true;
+    for (size_t i = 0; i < count; i++) {
+        const Point2D& a = points[i];
+        const Point2D& b = points[(i + 1) % count];
+        if (sign(b, center, a) < WideScalar()) inside = false;
+
+        if (segmentDistanceSquared(center, a, b) <= radiusSquared) {
+            return true;
+        }
+    }
+    return inside;
+}
+
+bool CollisionManager::checkConvexConvex(const Point2D* a, size_t countA, const Point2D* b, size_t countB) const {
+    // SAT - osiami rozdzielającymi mogą być tylko normalne krawędzi obu części
+    for (int pass = 0; pass < 2; pass++) {
+        const Point2D* edges = pass == 0 ? a : b;
+        size_t edgeCount = pass == 0 ? countA : countB;
+        for (size_t i = 0; i < edgeCount; i++) {
+            const Point2D& from = edges[i];
+            const Point2D& to = edges[(i + 1) % edgeCount];
+            Scalar axisX = from.getSimY() - to.getSimY();
+            Scalar axisY = to.getSimX() - from.getSimX();
+
+            WideScalar minA = SimMath::mulWide(axisX, a[0].getSimX()) + SimMath::mulWide(axisY, a[0].getSimY());
+            WideScalar maxA = minA;
+            for (size_t k = 1; k < countA; k++) {
+                WideScalar projection = SimMath::mulWide(axisX, a[k].getSimX()) + SimMath::mulWide(axisY, a[k].getSimY());
+                minA = std::min(minA, projection);
+                maxA = std::max(maxA, projection);
+            }
+            WideScalar minB = SimMath::mulWide(axisX, b[0].getSimX()) + SimMath::mulWide(axisY, b[0].getSimY());
+            WideScalar maxB = minB;
+            for (size_t k = 1; k < countB; k++) {
+                WideScalar projection = SimMath::mulWide(axisX, b[k].getSimX()) + SimMath::mulWide(axisY, b[k].getSimY());
+                minB = std::min(minB, projection);
+                maxB = std::max(maxB, projection);
+            }
+            if (maxA < minB || maxB < minA) {
+                return false;
             }
         }
     }
+    return true;
+}
+
+bool CollisionManager::checkPolygon(const Collision* other, const Collision* polygonCollision) const {
+    const Polygon* polygon = polygonCollision->getPolygon();
+    if (!polygon) return false;
+
+    // Kształt drugiej kolizji jako część wypukła (poza kołem)
+    Point2D otherPoints[4];
+    size_t otherCount = 0;
+    switch (other->getShape()) {
+    case CollisionShape::RECTANGLE: {
+        Point2D pos = other->getPosition();
+        otherPoints[0] = pos;
+        otherPoints[1] = Point2D::fromScalar(pos.getSimX() + other->getSimWidth(), pos.getSimY());
+        otherPoints[2] = Point2D::fromScalar(pos.getSimX() + other->getSimWidth(), pos.getSimY() + other->getSimHeight());
+        otherPoints[3] = Point2D::fromScalar(pos.getSimX(), pos.getSimY() + other->getSimHeight());
+        otherCount = 4;
+        break;
+    }
+    case CollisionShape::TRIANGLE:
+        for (size_t i = 0; i < 3; i++) {
+            otherPoints[i] = other->getTrianglePoints()[i];
+        }
+        otherCount = 3;
+        break;
+    default:
+        break;
+    }
 
+    const AABB& otherBounds = other->getBounds();
+    for (size_t i = 0; i < polygon->getConvexPieceCount(); i++) {
+        if (!polygon->getConvexPieceBounds(i).overlaps(otherBounds)) continue;
+
+        size_t count;
+        const Point2D* piece = polygon->getConvexPiece(i, count);
+        switch (other->getShape()) {
+        case CollisionShape::CIRCLE:
+            if (checkCircleConvex(other->getPosition(), other->getSimRadius(), piece, count)) return true;
+            break;
+        case CollisionShape::POLYGON: {
+            const Polygon* otherPolygon = other->getPolygon();
+            if (!otherPolygon) return false;
+            for (size_t k = 0; k < otherPolygon->getConvexPieceCount(); k++) {
+                size_t otherPieceCount;
+                const Point2D* otherPiece = otherPolygon->getConvexPiece(k, otherPieceCount);
+                if (checkConvexConvex(piece, count, otherPiece, otherPieceCount)) return true;
+            }
+            break;
+        }
+        default:
+            if (checkConvexConvex(piece, count, otherPoints, otherCount)) return true;
+            break;
+        }
+    }
     return false;
 }
 
 bool CollisionManager::checkCollision(const Collision* a, const Collision* b) const {
     if (!a || !b || !a->isActive() || !b->isActive()) return false;
 
-    if (a->getShape() == CollisionShape::CIRCLE && b->getShape() == CollisionShape::CIRCLE) {
+    // Wczesne odrzucenie - rozłączne prostokąty otaczające wykluczają kolizję
+    if (!a->getBounds().overlaps(b->getBounds())) return false;
+
+    if (a->getShape() == CollisionShape::POLYGON) {
+        return checkPolygon(b, a);
+    }
+    else if (b->getShape() == CollisionShape::POLYGON) {
+        return checkPolygon(a, b);
+    }
+    else if (a->getShape() == CollisionShape::CIRCLE && b->getShape() == CollisionShape::CIRCLE) {
         return checkCircleCircle(a, b);
     }
     else if (a->getShape() == CollisionShape::CIRCLE && b->getShape() == CollisionShape::RECTANGLE) {
@@ -0,0 +1,39 @@
+﻿/**
+ * @file RasterCheck.cpp
+ * @brief Narzędzie regresji obrazów rasteryzera (osobny cel, poza plikiem gry)
+ *
+ * Użycie (z katalogu głównego repozytorium):
+ *   RasterCheck --raster-check [katalog] [spowolnienie]  porównuje figury z obrazami wzorcowymi;
+ *                                                        czasy tylko raportuje, chyba że podano
+ *                                                        dopuszczalne spowolnienie (np. 2)
+ *   RasterCheck --raster-record [katalog]                zapisuje nowe obrazy wzorcowe i czasy
+ */
+
+#include "../../src/engine/RasterDiagnostics.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "--raster-check";
+    if (mode != "--raster-check" && mode != "--raster-record") {
+        std::cerr << "Usage: RasterCheck [--raster-check|--raster-record] [directory] [max slowdown]" << std::endl;
+        return 2;
+    }
+    std::string directory = argc > 2 ? argv[2] : "assets/golden/raster";
+
+    RasterDiagnostics diagnostics(directory);
+    if (argc > 3) {
+        // Bramka czasu ma sens tylko dla czasów zapisanych na tej samej maszynie
+        diagnostics.setMaxSlowdown(static_cast<float>(std::atof(argv[3])));
+    }
+    bool passed = diagnostics.run(mode == "--raster-record");
+    diagnostics.printReport(std::cout);
+    PrimitiveRenderer::releaseInstance();
+
+    if (!passed) {
+        std::cerr << "Raster diagnostics failed (golden directory: " << directory << ")" << std::endl;
+        return 1;
+    }
+    return 0;
+}